@@ -0,0 +1,308 @@
+/**
+ * @file batch.cpp
+ * @brief Реализация пакетного режима: потоковое чтение запросов, параллельное выполнение и буферизованный вывод.
+ */
+
+#include "batch.hpp"
+#include "options.hpp"
+#include "parallel.hpp"
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+const size_t kMaxChunkQueries = 1 << 16; ///< Наибольшее число запросов в одном блоке
+const size_t kChunkValueBudget = 1 << 24; ///< Наибольшее число расстояний в результатах одного блока
+const size_t kClaimsPerThread = 8; ///< Порций блока на поток: баланс нагрузки против обращений к общему счётчику
+
+/**
+ * @brief Разбирает строку запроса.
+ * @param line Строка файла запросов.
+ * @param lineNumber Номер строки (для сообщения об ошибке).
+ * @param query Результат разбора.
+ * @return false, если строка пустая или является комментарием.
+ * @throws runtime_error Если строка не содержит корректного запроса.
+ */
+bool parseQueryLine(const string& line, size_t lineNumber, BatchQuery& query) {
+    auto fail = [&]() {
+        return runtime_error("Некорректный запрос в строке " + to_string(lineNumber) + ": " + line);
+    };
+    auto skipSpace = [end = line.data() + line.size()](const char* p) {
+        while (p < end && isspace(static_cast<unsigned char>(*p))) ++p;
+        return p;
+    };
+
+    const char* end = line.data() + line.size();
+    const char* p = skipSpace(line.data());
+    if (p == end || *p == '#') {
+        return false;
+    }
+
+    auto first = from_chars(p, end, query.source);
+    if (first.ec != errc()) {
+        throw fail();
+    }
+    p = skipSpace(first.ptr);
+    query.target = -1;
+    if (p == end) {
+        return true;
+    }
+
+    // -1 — единственное допустимое отрицательное значение: «без конечной вершины»
+    auto second = from_chars(p, end, query.target);
+    if (second.ec != errc() || query.target < -1 || skipSpace(second.ptr) != end) {
+        throw fail();
+    }
+    return true;
+}
+
+/**
+ * @brief Дописывает число в строку без промежуточных потоков.
+ * @param out Строка результата.
+ * @param value Число; INT_MAX (недостижимая вершина) записывается как -1.
+ */
+void appendDistance(string& out, int value) {
+    if (value == numeric_limits<int>::max()) {
+        value = -1;
+    }
+    char buf[16];
+    auto result = to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, result.ptr);
+}
+
+/**
+ * @brief Выполняет один запрос и форматирует строку результата.
+ * @param graph Граф.
+ * @param labels Хабовые метки или nullptr, если запрос выполняется поиском по графу.
+ * @param query Запрос.
+ * @param useSimple Использовать простой алгоритм Дейкстры вместо бинарной кучи.
+ * @param scratch Рабочие буферы потока.
+ * @param out Строка результата (перезаписывается).
+ */
+void answerQuery(const Graph& graph, const HubLabels* labels, const BatchQuery& query, bool useSimple,
+                 SearchScratch& scratch, string& out) {
+    out.clear();
+    appendDistance(out, query.source);
+
+    if (labels) {
+        if (query.target >= 0) {
+            out.push_back(' ');
+            appendDistance(out, query.target);
+            out.push_back(' ');
+            appendDistance(out, labels->query(query.source, query.target));
+        } else {
+            out.push_back(':');
+            for (int t = 0; t < labels->getVertexCount(); ++t) {
+                out.push_back(' ');
+                appendDistance(out, labels->query(query.source, t));
+            }
+        }
+        out.push_back('\n');
+        return;
+    }
+
+    vector<int> simpleDist;
+    const vector<int>* dist;
+    if (useSimple) {
+        simpleDist = graph.dijkstraSimple(query.source);
+        dist = &simpleDist;
+    } else {
+        graph.searchFrom(query.source, scratch, query.target);
+        dist = &scratch.dist;
+    }
+
+    if (query.target >= 0) {
+        out.push_back(' ');
+        appendDistance(out, query.target);
+        out.push_back(' ');
+        appendDistance(out, (*dist)[query.target]);
+    } else {
+        out.push_back(':');
+        for (int d : *dist) {
+            out.push_back(' ');
+            appendDistance(out, d);
+        }
+    }
+    out.push_back('\n');
+}
+
+} // namespace
+
+BufferedWriter::BufferedWriter(const string& fileName, size_t capacity)
+    : file(nullptr), ownsFile(false), buffer(capacity), used(0) {
+    if (fileName.empty() || fileName == "-") {
+        file = stdout;
+    } else {
+        file = fopen(fileName.c_str(), "wb");
+        if (!file) {
+            throw runtime_error("Ошибка открытия файла для записи: " + fileName);
+        }
+        ownsFile = true;
+    }
+}
+
+BufferedWriter::~BufferedWriter() {
+    try {
+        flush();
+    } catch (...) {
+        // Ошибку записи уже нельзя передать вызывающему коду
+    }
+    if (ownsFile) {
+        fclose(file);
+    }
+}
+
+void BufferedWriter::write(const char* data, size_t size) {
+    if (used + size > buffer.size()) {
+        flush();
+        if (size > buffer.size()) {
+            if (fwrite(data, 1, size, file) != size) {
+                throw runtime_error("Ошибка записи результатов");
+            }
+            return;
+        }
+    }
+    memcpy(buffer.data() + used, data, size);
+    used += size;
+}
+
+void BufferedWriter::flush() {
+    if (used > 0 && fwrite(buffer.data(), 1, used, file) != used) {
+        used = 0;
+        throw runtime_error("Ошибка записи результатов");
+    }
+    used = 0;
+    fflush(file);
+}
+
+BatchOptions parseBatchOptions(int argc, char* argv[]) {
+    BatchOptions options;
+    options.threads = max(1u, thread::hardware_concurrency());
+
+    forEachOption(argc, argv, 1, [&](const string& arg, const string& value) {
+        if (arg == "--graph") {
+            options.graphFile = value;
+        } else if (arg == "--queries") {
+            options.queriesFile = value;
+        } else if (arg == "--output") {
+            options.outputFile = value;
+        } else if (arg == "--threads") {
+            options.threads = parseThreadsOption(arg, value);
+        } else if (arg == "--labels") {
+            options.labelsFile = value;
+        } else if (arg == "--algo") {
+            if (value != "dijkstra" && value != "simple" && value != "hub") {
+                throw runtime_error("Неизвестный алгоритм: " + value);
+            }
+            options.algo = value;
+        } else {
+            throw runtime_error("Неизвестный параметр: " + arg);
+        }
+    });
+
+    bool hub = options.algo == "hub";
+    if (options.queriesFile.empty() || (hub ? options.labelsFile.empty() : options.graphFile.empty())) {
+        throw runtime_error("Использование: --graph файл --queries файл [--threads N] "
+                            "[--algo dijkstra|simple] [--output файл]\n"
+                            "              --algo hub --labels файл --queries файл [--graph файл] [--threads N] "
+                            "[--output файл]");
+    }
+    return options;
+}
+
+void runBatch(const BatchOptions& options) {
+    // Метки отвечают на запросы без графа; граф загружается в режиме hub только для проверки меток
+    Graph graph(0);
+    int startVertex;
+    HubLabels labels;
+    if (options.algo == "hub") {
+        labels = HubLabels::load(options.labelsFile);
+        if (!options.graphFile.empty()) {
+            graph.loadFromFile(options.graphFile, startVertex);
+            if (!labels.matches(graph)) {
+                throw runtime_error("Файл меток построен для другого графа: " + options.labelsFile);
+            }
+        }
+    } else {
+        graph.loadFromFile(options.graphFile, startVertex);
+    }
+    const HubLabels* oracle = options.algo == "hub" ? &labels : nullptr;
+    const int vertexCount = oracle ? labels.getVertexCount() : graph.getVertexCount();
+
+    vector<char> inputBuffer(1 << 20);
+    ifstream inFile;
+    inFile.rdbuf()->pubsetbuf(inputBuffer.data(), inputBuffer.size());
+    inFile.open(options.queriesFile);
+    if (!inFile) {
+        throw runtime_error("Ошибка открытия файла: " + options.queriesFile);
+    }
+
+    const bool useSimple = options.algo == "simple";
+
+    // Потоки запускаются один раз и выполняют все блоки
+    WorkerPool pool(options.threads);
+    BufferedWriter out(options.outputFile);
+    vector<SearchScratch> scratch(pool.size());
+    vector<BatchQuery> queries;
+    vector<string> results;
+    queries.reserve(kMaxChunkQueries);
+
+    // Блок ограничен объёмом результатов: запрос "s t" даёт одно расстояние, запрос "s" — V.
+    // Запрос, не поместившийся в блок, переносится в следующий.
+    string line;
+    size_t lineNumber = 0;
+    BatchQuery carried;
+    bool hasCarried = false;
+    while (true) {
+        queries.clear();
+        size_t chunkValues = 0;
+        while (queries.size() < kMaxChunkQueries) {
+            BatchQuery query;
+            if (hasCarried) {
+                query = carried;
+                hasCarried = false;
+            } else {
+                if (!getline(inFile, line)) {
+                    break;
+                }
+                ++lineNumber;
+                if (!parseQueryLine(line, lineNumber, query)) {
+                    continue;
+                }
+                if (query.source < 0 || query.source >= vertexCount || query.target >= vertexCount) {
+                    throw runtime_error("Вершина вне диапазона в строке " + to_string(lineNumber) + ": " + line);
+                }
+            }
+            size_t values = query.target >= 0 ? 1 : static_cast<size_t>(vertexCount);
+            if (!queries.empty() && chunkValues + values > kChunkValueBudget) {
+                carried = query;
+                hasCarried = true;
+                break;
+            }
+            chunkValues += values;
+            queries.push_back(query);
+        }
+        if (queries.empty()) {
+            break;
+        }
+
+        if (results.size() < queries.size()) {
+            results.resize(queries.size());
+        }
+
+        // Порция зависит от размера блока, чтобы каждому потоку досталось несколько порций
+        size_t claim = max<size_t>(1, queries.size() / (static_cast<size_t>(pool.size()) * kClaimsPerThread));
+        pool.forEachIndex(queries.size(), claim, [&](int id, size_t i) {
+            answerQuery(graph, oracle, queries[i], useSimple, scratch[id], results[i]);
+        });
+
+        // Вывод в исходном порядке запросов
+        for (size_t i = 0; i < queries.size(); ++i) {
+            out.write(results[i]);
+        }
+    }
+
+    out.flush();
+}
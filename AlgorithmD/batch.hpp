@@ -0,0 +1,106 @@
+/**
+ * @file batch.hpp
+ * @brief Пакетный (неинтерактивный) режим выполнения запросов кратчайших путей.
+ */
+
+#ifndef batch_hpp
+#define batch_hpp
+
+#include "my_lab.hpp"
+#include "hub_labels.hpp"
+#include <cstdio>
+
+/**
+ * @struct BatchOptions
+ * @brief Параметры пакетного режима, полученные из командной строки.
+ */
+struct BatchOptions {
+    string graphFile; ///< Файл с матрицей смежности графа (--graph); для "hub" необязателен и служит для проверки меток
+    string queriesFile; ///< Файл с запросами (--queries)
+    string outputFile; ///< Файл результатов (--output); пустая строка или "-" — стандартный вывод
+    int threads = 1; ///< Количество рабочих потоков (--threads)
+    string algo = "dijkstra"; ///< Алгоритм: "dijkstra" (бинарная куча), "simple" или "hub" (--algo)
+    string labelsFile; ///< Файл хабовых меток для алгоритма "hub" (--labels)
+};
+
+/**
+ * @struct BatchQuery
+ * @brief Один запрос из файла запросов.
+ */
+struct BatchQuery {
+    int source; ///< Начальная вершина
+    int target; ///< Конечная вершина или -1, если нужны расстояния до всех вершин
+};
+
+/**
+ * @class BufferedWriter
+ * @brief Буферизованная запись в файл или стандартный вывод крупными блоками.
+ */
+class BufferedWriter {
+private:
+    FILE* file; ///< Файл назначения
+    bool ownsFile; ///< Нужно ли закрыть файл в деструкторе
+    vector<char> buffer; ///< Буфер записи
+    size_t used; ///< Заполненная часть буфера
+
+public:
+    /**
+     * @brief Открывает файл для записи.
+     * @param fileName Имя файла; пустая строка или "-" — стандартный вывод.
+     * @param capacity Размер буфера в байтах.
+     * @throws runtime_error Если файл не удалось открыть.
+     */
+    explicit BufferedWriter(const string& fileName, size_t capacity = 1 << 22);
+
+    /**
+     * @brief Сбрасывает буфер и закрывает файл.
+     */
+    ~BufferedWriter();
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    /**
+     * @brief Добавляет данные в буфер, при переполнении записывает его в файл.
+     * @param data Указатель на данные.
+     * @param size Размер данных в байтах.
+     * @throws runtime_error Если запись завершилась ошибкой.
+     */
+    void write(const char* data, size_t size);
+
+    /**
+     * @brief Добавляет строку в буфер.
+     * @param text Записываемая строка.
+     */
+    void write(const string& text) { write(text.data(), text.size()); }
+
+    /**
+     * @brief Записывает содержимое буфера в файл.
+     * @throws runtime_error Если запись завершилась ошибкой.
+     */
+    void flush();
+};
+
+/**
+ * @brief Разбирает аргументы командной строки пакетного режима.
+ * @param argc Количество аргументов.
+ * @param argv Аргументы командной строки.
+ * @return Параметры пакетного режима.
+ * @throws runtime_error Если аргументы заданы неверно.
+ */
+BatchOptions parseBatchOptions(int argc, char* argv[]);
+
+/**
+ * @brief Выполняет запросы из файла и записывает результаты в порядке запросов.
+ *
+ * Файл запросов читается блоками с ограниченным числом расстояний в результатах,
+ * поэтому объём памяти не зависит от числа запросов. Каждая строка содержит
+ * либо одну вершину s (расстояния до всех вершин), либо пару "s t" (расстояние
+ * от s до t). Запросы блока выполняются параллельно потоками, запущенными один
+ * раз на весь файл; у каждого потока собственный SearchScratch.
+ * @param options Параметры пакетного режима.
+ * @throws runtime_error Если файл не удалось открыть или запрос некорректен.
+ */
+void runBatch(const BatchOptions& options);
+
+#endif /* batch_hpp */
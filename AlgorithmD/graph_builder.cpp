@@ -0,0 +1,250 @@
+/**
+ * @file graph_builder.cpp
+ * @brief Реализация GraphBuilder: буферы производителей и параллельная раскладка рёбер по вершинам.
+ */
+
+#include "graph_builder.hpp"
+#include "parallel.hpp"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+const size_t kBucketEdges = 1 << 17; ///< Среднее число рёбер в корзине (раскладка корзины помещается в кэш L2)
+
+/**
+ * @struct Slot
+ * @brief Ребро после раскладки по вершине-источнику.
+ */
+struct Slot {
+    int v; ///< Вершина-назначение
+    int weight; ///< Вес ребра
+};
+
+} // namespace
+
+GraphBuilder::GraphBuilder(int vertices, int producers) : vertices(vertices) {
+    if (vertices < 0 || producers < 1) {
+        throw runtime_error("Некорректные параметры построения графа");
+    }
+    buffers.resize(producers);
+}
+
+size_t GraphBuilder::getPendingEdgeCount() const {
+    size_t total = 0;
+    for (const Buffer& buffer : buffers) {
+        total += buffer.edges.size();
+    }
+    return total;
+}
+
+Graph GraphBuilder::build(int threads) {
+    WorkerPool pool(threads);
+    threads = pool.size();
+
+    // Буферы образуют одну последовательность рёбер; поток обрабатывает её непрерывный отрезок
+    vector<size_t> bufferStart(buffers.size() + 1, 0);
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        bufferStart[i + 1] = bufferStart[i] + buffers[i].edges.size();
+    }
+    const size_t total = bufferStart.back();
+    auto forEachEdge = [&](int id, auto&& visit) {
+        size_t begin = total * id / threads;
+        size_t end = total * (id + 1) / threads;
+        size_t b = upper_bound(bufferStart.begin(), bufferStart.end(), begin) - bufferStart.begin() - 1;
+        while (begin < end) {
+            const vector<Edge>& edges = buffers[b].edges;
+            size_t stop = min(end, bufferStart[b + 1]);
+            for (size_t i = begin - bufferStart[b]; i < stop - bufferStart[b]; ++i) {
+                visit(edges[i]);
+            }
+            begin = stop;
+            ++b;
+        }
+    };
+
+    // Корзина — диапазон из 2^shift вершин, в среднем около kBucketEdges рёбер.
+    // Раскладка сразу по вершинам обращалась бы к случайной строке кэша на каждое ребро;
+    // раскладка по корзинам пишет в небольшое число последовательных потоков,
+    // а раскладка внутри корзины помещается в кэш.
+    int shift = 0;
+    while ((1 << shift) < vertices && (static_cast<size_t>(2) << shift) * total <= kBucketEdges * static_cast<size_t>(vertices)) {
+        ++shift;
+    }
+    const int bucketCount = vertices == 0 ? 0 : ((vertices - 1) >> shift) + 1;
+
+    // Первый проход: число рёбер каждого потока в каждой корзине
+    vector<vector<size_t>> cursor(threads, vector<size_t>(bucketCount, 0));
+    pool.run([&](int id) {
+        vector<size_t>& count = cursor[id];
+        forEachEdge(id, [&](const Edge& e) { count[e.u >> shift]++; });
+    });
+
+    // Поток получает в каждой корзине свой отрезок, поэтому раскладка не требует синхронизации
+    vector<size_t> bucketStart(bucketCount + 1, 0);
+    size_t position = 0;
+    for (int b = 0; b < bucketCount; ++b) {
+        bucketStart[b] = position;
+        for (int id = 0; id < threads; ++id) {
+            size_t count = cursor[id][b];
+            cursor[id][b] = position;
+            position += count;
+        }
+    }
+    bucketStart[bucketCount] = position;
+
+    // Второй проход: раскладка рёбер по корзинам
+    auto partitioned = make_unique_for_overwrite<Edge[]>(total);
+    pool.run([&](int id) {
+        vector<size_t>& next = cursor[id];
+        forEachEdge(id, [&](const Edge& e) { partitioned[next[e.u >> shift]++] = e; });
+    });
+    for (Buffer& buffer : buffers) {
+        vector<Edge>().swap(buffer.edges);
+    }
+
+    // Внутри корзины: раскладка по вершинам, сортировка списков, удаление петель и повторов
+    // (после сортировки первым идёт наименьший вес)
+    Graph graph(vertices);
+    vector<vector<size_t>> offsetBuffers(threads);
+    vector<vector<Slot>> slotBuffers(threads);
+    atomic<size_t> kept(0);
+    pool.forEachIndex(bucketCount, 1, [&](int id, size_t bucket) {
+        vector<size_t>& offsets = offsetBuffers[id];
+        vector<Slot>& slots = slotBuffers[id];
+        const int b = static_cast<int>(bucket);
+        const int first = b << shift;
+        const int last = min(vertices, first + (1 << shift));
+        const Edge* begin = partitioned.get() + bucketStart[b];
+        const Edge* end = partitioned.get() + bucketStart[b + 1];
+        size_t local = 0;
+
+        offsets.assign(last - first + 1, 0);
+        for (const Edge* e = begin; e != end; ++e) {
+            offsets[e->u - first + 1]++;
+        }
+        for (int i = 1; i <= last - first; ++i) {
+            offsets[i] += offsets[i - 1];
+        }
+        slots.resize(end - begin);
+        for (const Edge* e = begin; e != end; ++e) {
+            slots[offsets[e->u - first]++] = {e->v, e->weight};
+        }
+
+        // После раскладки offsets[i] указывает на конец списка вершины first + i
+        size_t listBegin = 0;
+        for (int u = first; u < last; ++u) {
+            Slot* head = slots.data() + listBegin;
+            Slot* tail = slots.data() + offsets[u - first];
+            listBegin = offsets[u - first];
+            sort(head, tail, [](const Slot& x, const Slot& y) {
+                return x.v != y.v ? x.v < y.v : x.weight < y.weight;
+            });
+            Slot* out = head;
+            for (Slot* s = head; s != tail; ++s) {
+                if (s->v != u && (out == head || (out - 1)->v != s->v)) {
+                    *out++ = *s;
+                }
+            }
+            auto& edges = graph.adjList[u];
+            edges.reserve(out - head);
+            for (Slot* s = head; s != out; ++s) {
+                edges.emplace_back(s->v, s->weight);
+            }
+            local += out - head;
+        }
+        kept += local;
+    });
+
+    if (kept > static_cast<size_t>(numeric_limits<int>::max())) {
+        throw runtime_error("Слишком много рёбер для графа: " + to_string(kept.load()));
+    }
+    graph.edgeCount = static_cast<int>(kept);
+    return graph;
+}
+
+void analyzeGraphBuilder() {
+    const int vertices = 1000000;
+    const size_t edgeTotal = 10000000;
+
+    // Ребро с номером i не зависит от числа производителей: все замеры строят один и тот же граф
+    auto edgeAt = [](size_t i, int& u, int& v, int& weight) {
+        uint64_t z = (i + 1) * 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+        u = static_cast<int>((z & 0xFFFFFFFFULL) % vertices);
+        v = static_cast<int>((z >> 32) % vertices);
+        weight = static_cast<int>(z % 10) + 1;
+    };
+
+    // Последовательное добавление через Graph::addEdge (без удаления повторов)
+    auto addStart = chrono::high_resolution_clock::now();
+    Graph reference(vertices);
+    for (size_t i = 0; i < edgeTotal; ++i) {
+        int u, v, weight;
+        edgeAt(i, u, v, weight);
+        reference.addEdge(u, v, weight);
+    }
+    auto addEnd = chrono::high_resolution_clock::now();
+    auto addTime = chrono::duration_cast<chrono::milliseconds>(addEnd - addStart).count();
+
+    ofstream outFile("graph_builder.dat");
+    outFile << "Producers InputEdges GraphEdges IngestMs BuildMs TotalMs AddEdgeMs\n";
+
+    const int maxProducers = max(4, static_cast<int>(thread::hardware_concurrency()));
+    for (int producers = 1; producers <= maxProducers; producers *= 2) {
+        GraphBuilder builder(vertices, producers);
+        WorkerPool pool(producers);
+
+        auto ingestStart = chrono::high_resolution_clock::now();
+        pool.run([&](int id) {
+            size_t begin = edgeTotal * id / producers;
+            size_t end = edgeTotal * (id + 1) / producers;
+            builder.reserve(id, end - begin);
+            for (size_t i = begin; i < end; ++i) {
+                int u, v, weight;
+                edgeAt(i, u, v, weight);
+                builder.addEdge(id, u, v, weight);
+            }
+        });
+        auto ingestEnd = chrono::high_resolution_clock::now();
+        Graph graph = builder.build(producers);
+        auto buildEnd = chrono::high_resolution_clock::now();
+
+        // Проверка: списки совпадают с упорядоченными списками Graph::addEdge без петель и повторов
+        long long expectedEdges = 0;
+        vector<pair<int, int>> expected, actual;
+        for (int u = 0; u < vertices; ++u) {
+            expected.clear();
+            actual.clear();
+            reference.forEachNeighbor(u, [&](int v, int weight) {
+                if (v != u) {
+                    expected.emplace_back(v, weight);
+                }
+            });
+            sort(expected.begin(), expected.end());
+            expected.erase(unique(expected.begin(), expected.end(),
+                                  [](const pair<int, int>& a, const pair<int, int>& b) { return a.first == b.first; }),
+                           expected.end());
+            graph.forEachNeighbor(u, [&](int v, int weight) { actual.emplace_back(v, weight); });
+            if (expected != actual) {
+                throw runtime_error("Граф GraphBuilder не совпадает с графом Graph::addEdge в вершине " + to_string(u));
+            }
+            expectedEdges += static_cast<long long>(expected.size());
+        }
+        if (graph.getEdgeCount() != expectedEdges) {
+            throw runtime_error("Неверное количество рёбер графа GraphBuilder");
+        }
+
+        auto ingestTime = chrono::duration_cast<chrono::milliseconds>(ingestEnd - ingestStart).count();
+        auto buildTime = chrono::duration_cast<chrono::milliseconds>(buildEnd - ingestEnd).count();
+        outFile << producers << " " << edgeTotal << " " << graph.getEdgeCount() << " " << ingestTime << " "
+                << buildTime << " " << ingestTime + buildTime << " " << addTime << "\n";
+    }
+
+    outFile.close();
+}
@@ -0,0 +1,110 @@
+/**
+ * @file graph_builder.hpp
+ * @brief Параллельное накопление рёбер от нескольких потоков и построение графа.
+ */
+
+#ifndef graph_builder_hpp
+#define graph_builder_hpp
+
+#include "my_lab.hpp"
+
+/**
+ * @class GraphBuilder
+ * @brief Накопитель рёбер, принимающий рёбра одновременно от нескольких потоков-производителей.
+ *
+ * У каждого производителя свой буфер рёбер, поэтому addEdge не использует
+ * блокировок и атомарных операций. Метод build переводит накопленные рёбра
+ * в списки смежности Graph параллельным подсчётом и раскладкой,
+ * удаляя петли и повторяющиеся рёбра (остаётся ребро с наименьшим весом).
+ * Получается ориентированный граф.
+ */
+class GraphBuilder {
+public:
+    /**
+     * @brief Создаёт накопитель.
+     * @param vertices Количество вершин графа.
+     * @param producers Количество потоков-производителей.
+     * @throws runtime_error Если параметры некорректны.
+     */
+    GraphBuilder(int vertices, int producers);
+
+    /**
+     * @brief Резервирует место в буфере производителя.
+     * @param producer Номер производителя.
+     * @param edges Ожидаемое количество рёбер.
+     */
+    void reserve(int producer, size_t edges) { buffers[producer].edges.reserve(edges); }
+
+    /**
+     * @brief Добавляет ребро в буфер производителя.
+     *
+     * Безопасен для одновременного вызова из разных потоков при условии,
+     * что каждый поток использует свой номер производителя.
+     * @param producer Номер производителя (от 0 до producers - 1).
+     * @param u Вершина-источник.
+     * @param v Вершина-назначение.
+     * @param weight Вес ребра.
+     * @throws runtime_error Если вершина вне диапазона.
+     */
+    void addEdge(int producer, int u, int v, int weight) {
+        if (static_cast<unsigned>(u) >= static_cast<unsigned>(vertices) ||
+            static_cast<unsigned>(v) >= static_cast<unsigned>(vertices)) {
+            throw runtime_error("Вершина ребра вне диапазона: " + to_string(u) + " -> " + to_string(v));
+        }
+        buffers[producer].edges.push_back({u, v, weight});
+    }
+
+    /**
+     * @brief Возвращает количество накопленных рёбер (до удаления повторов).
+     *
+     * Вызывается, когда производители не добавляют рёбра.
+     * @return Количество рёбер во всех буферах.
+     */
+    size_t getPendingEdgeCount() const;
+
+    /**
+     * @brief Строит граф из накопленных рёбер и очищает буферы.
+     *
+     * Первый проход считает рёбра каждого потока в корзинах (диапазонах
+     * вершин), второй раскладывает рёбра по корзинам в отведённые потоку
+     * отрезки. Затем каждая корзина раскладывается по вершинам в кэше,
+     * списки сортируются и очищаются от петель и повторов. Все этапы
+     * выполняются параллельно. Вызывается после завершения всех производителей.
+     * @param threads Количество потоков (0 — по числу ядер).
+     * @return Ориентированный граф; getEdgeCount() учитывает только оставшиеся рёбра.
+     * @throws runtime_error Если рёбер больше, чем помещается в счётчик рёбер графа.
+     */
+    Graph build(int threads = 0);
+
+private:
+    /**
+     * @struct Edge
+     * @brief Ребро в буфере производителя.
+     */
+    struct Edge {
+        int u; ///< Вершина-источник
+        int v; ///< Вершина-назначение
+        int weight; ///< Вес ребра
+    };
+
+    /**
+     * @struct Buffer
+     * @brief Буфер одного производителя; выравнивание по строке кэша исключает ложное разделение.
+     */
+    struct alignas(64) Buffer {
+        vector<Edge> edges; ///< Добавленные рёбра
+    };
+
+    int vertices; ///< Количество вершин графа
+    vector<Buffer> buffers; ///< Буферы производителей
+};
+
+/**
+ * @brief Сравнивает построение графа через GraphBuilder при разном числе производителей
+ *        с последовательным добавлением рёбер через Graph::addEdge.
+ *        Результаты сохраняются в файл "graph_builder.dat".
+ * @throws runtime_error Если графы, построенные разными способами, различаются.
+ */
+void analyzeGraphBuilder();
+
+#endif /* graph_builder_hpp */
@@ -0,0 +1,190 @@
+/**
+ * @file hub_labels.hpp
+ * @brief Оракул расстояний на основе хабовых меток (pruned landmark labeling).
+ */
+
+#ifndef hub_labels_hpp
+#define hub_labels_hpp
+
+#include "my_lab.hpp"
+#include <cstdint>
+
+/**
+ * @class HubLabels
+ * @brief Хабовые метки для ответа на запросы расстояния без поиска по графу.
+ *
+ * Для каждой вершины хранятся метки: пары (хаб, расстояние), упорядоченные
+ * по рангу хаба, в виде непрерывных массивов хабов и расстояний. Расстояние
+ * s -> t равно минимуму d(s, h) + d(h, t) по общим хабам h выходной метки s
+ * и входной метки t (для неориентированного графа метки совпадают).
+ * Метки хранятся в одном блоке памяти того же формата, что и файл, поэтому
+ * сохранённый файл загружается через mmap без разбора и копирования.
+ */
+class HubLabels {
+public:
+    /**
+     * @brief Порядок обработки вершин (ранги хабов).
+     */
+    enum class Order {
+        Degree, ///< По убыванию степени вершины
+        Centrality ///< По оценке посредничества на выборке деревьев кратчайших путей
+    };
+
+    HubLabels() = default;
+    ~HubLabels();
+    HubLabels(HubLabels&& other) noexcept;
+    HubLabels& operator=(HubLabels&& other) noexcept;
+    HubLabels(const HubLabels&) = delete;
+    HubLabels& operator=(const HubLabels&) = delete;
+
+    /**
+     * @brief Строит метки алгоритмом pruned landmark labeling.
+     *
+     * Вершины обрабатываются в порядке рангов. Первые вершины (они отсекают
+     * больше всего) обрабатываются по одной, далее — пакетами, поиски внутри
+     * пакета выполняются параллельно и отсекаются только метками предыдущих
+     * пакетов. Это может немного увеличить метки, но не влияет на точность.
+     * @param graph Граф с неотрицательными весами.
+     * @param order Порядок вершин.
+     * @param threads Количество потоков (0 — по числу ядер).
+     * @return Построенные метки.
+     */
+    static HubLabels build(const Graph& graph, Order order, int threads = 0);
+
+    /**
+     * @brief Отображает файл меток в память (mmap).
+     *
+     * Перед использованием проверяются заголовок, смещения меток и ограничители,
+     * поэтому повреждённый файл не приводит к чтению за пределами отображения.
+     * @param fileName Имя файла меток.
+     * @return Метки, ссылающиеся на отображённый файл.
+     * @throws runtime_error Если файл не удалось открыть или он повреждён.
+     */
+    static HubLabels load(const string& fileName);
+
+    /**
+     * @brief Сохраняет метки в файл.
+     * @param fileName Имя выходного файла.
+     * @throws runtime_error Если файл не удалось записать.
+     */
+    void save(const string& fileName) const;
+
+    /**
+     * @brief Возвращает кратчайшее расстояние между вершинами.
+     *
+     * Пересечение меток выполняется слиянием без ветвлений на сдвигах
+     * указателей; каждая метка завершается ограничителем, поэтому проверки
+     * границ в цикле не нужны.
+     * @param source Начальная вершина.
+     * @param target Конечная вершина.
+     * @return Расстояние или INT_MAX, если вершина недостижима.
+     */
+    int query(int source, int target) const;
+
+    /**
+     * @brief Проверяет, построены ли метки по данному графу (по числу вершин и контрольной сумме рёбер).
+     * @param graph Граф.
+     * @return true, если граф совпадает с графом, по которому построены метки.
+     */
+    bool matches(const Graph& graph) const;
+
+    /**
+     * @brief Возвращает количество вершин графа.
+     * @return Количество вершин.
+     */
+    int getVertexCount() const { return header ? static_cast<int>(header->vertices) : 0; }
+
+    /**
+     * @brief Возвращает суммарное число записей во всех метках (без ограничителей).
+     * @return Количество записей.
+     */
+    uint64_t getEntryCount() const;
+
+    /**
+     * @brief Возвращает размер меток в памяти и в файле.
+     * @return Размер в байтах.
+     */
+    size_t getMemoryBytes() const { return size; }
+
+private:
+    /**
+     * @struct FileHeader
+     * @brief Заголовок файла меток.
+     */
+    struct FileHeader {
+        char magic[8]; ///< Сигнатура "HUBLBL2"
+        uint32_t vertices; ///< Количество вершин
+        uint32_t directed; ///< 1 — отдельные входные и выходные метки
+        uint64_t outEntries; ///< Записей в выходных метках (с ограничителями)
+        uint64_t inEntries; ///< Записей во входных метках (0 для неориентированного графа)
+        uint64_t graphChecksum; ///< Контрольная сумма графа, по которому построены метки
+    };
+
+    /**
+     * @struct Layout
+     * @brief Смещения массивов в блоке меток.
+     */
+    struct Layout {
+        size_t outOffsets, outHubs, outDists, inOffsets, inHubs, inDists, total;
+    };
+
+    static Layout layoutFor(uint32_t vertices, bool directed, uint64_t outEntries, uint64_t inEntries);
+
+    /**
+     * @brief Проверяет блок и настраивает указатели на его массивы.
+     * @param base Начало блока.
+     * @param blockSize Размер блока в байтах.
+     * @throws runtime_error Если блок повреждён.
+     */
+    void attach(const char* base, size_t blockSize);
+
+    void release();
+
+    vector<uint64_t> storage; ///< Собственный блок меток (после построения)
+    void* mapped = nullptr; ///< Отображённый файл (после загрузки)
+    size_t size = 0; ///< Размер блока в байтах
+
+    const FileHeader* header = nullptr;
+    const uint64_t* outOffsets = nullptr; ///< Начало выходной метки вершины (V + 1 элементов)
+    const int32_t* outHubs = nullptr; ///< Ранги хабов выходных меток
+    const int32_t* outDists = nullptr; ///< Расстояния до хабов
+    const uint64_t* inOffsets = nullptr; ///< Начало входной метки вершины
+    const int32_t* inHubs = nullptr; ///< Ранги хабов входных меток
+    const int32_t* inDists = nullptr; ///< Расстояния от хабов
+};
+
+/**
+ * @struct LabelBuildOptions
+ * @brief Параметры построения файла меток из командной строки.
+ */
+struct LabelBuildOptions {
+    string graphFile; ///< Файл с матрицей смежности графа (--graph)
+    string labelsFile; ///< Выходной файл меток (--labels)
+    HubLabels::Order order = HubLabels::Order::Degree; ///< Порядок вершин (--order degree|centrality)
+    int threads = 0; ///< Количество потоков (--threads)
+};
+
+/**
+ * @brief Разбирает аргументы командной строки построения меток (после --build-labels).
+ * @param argc Количество аргументов.
+ * @param argv Аргументы командной строки.
+ * @return Параметры построения.
+ * @throws runtime_error Если аргументы заданы неверно.
+ */
+LabelBuildOptions parseLabelBuildOptions(int argc, char* argv[]);
+
+/**
+ * @brief Загружает граф, строит метки и сохраняет их в файл.
+ * @param options Параметры построения.
+ */
+void runLabelBuild(const LabelBuildOptions& options);
+
+/**
+ * @brief Сравнивает хабовые метки с запуском алгоритма Дейкстры на каждый запрос
+ *        (время построения, объём памяти, задержка запроса).
+ *        Результаты сохраняются в файл "hub_labels.dat".
+ * @throws runtime_error Если ответы меток и алгоритма Дейкстры не совпадают.
+ */
+void analyzeHubLabels();
+
+#endif /* hub_labels_hpp */
@@ -0,0 +1,253 @@
+/**
+ * @file loadgen.cpp
+ * @brief Реализация генератора нагрузки: конвейерные запросы по нескольким соединениям.
+ */
+
+#include "loadgen.hpp"
+#include "options.hpp"
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief Подключается к Unix-сокету сервера.
+ * @param path Путь к сокету.
+ * @return Дескриптор соединения.
+ */
+int connectTo(const string& path) {
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw runtime_error("Слишком длинный путь к сокету: " + path);
+    }
+    address.sun_family = AF_UNIX;
+    memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        int error = errno;
+        if (fd >= 0) {
+            close(fd);
+        }
+        throw runtime_error("Ошибка подключения к " + path + ": " + strerror(error));
+    }
+    return fd;
+}
+
+/**
+ * @brief Записывает буфер целиком.
+ */
+void sendAll(int fd, const string& data) {
+    size_t offset = 0;
+    while (offset < data.size()) {
+        ssize_t written = write(fd, data.data() + offset, data.size() - offset);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            throw runtime_error("Ошибка отправки запроса: " + string(strerror(errno)));
+        }
+        offset += written;
+    }
+}
+
+/**
+ * @class ResponseReader
+ * @brief Буферизованное чтение ответов сервера.
+ */
+class ResponseReader {
+private:
+    int fd;
+    vector<char> buffer;
+    size_t begin = 0;
+    size_t end = 0;
+
+    void readExact(char* dst, size_t size) {
+        while (size > 0) {
+            if (begin == end) {
+                ssize_t received = read(fd, buffer.data(), buffer.size());
+                if (received < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (received <= 0) {
+                    throw runtime_error("Сервер закрыл соединение");
+                }
+                begin = 0;
+                end = received;
+            }
+            size_t part = min(size, end - begin);
+            if (dst) {
+                memcpy(dst, buffer.data() + begin, part);
+                dst += part;
+            }
+            begin += part;
+            size -= part;
+        }
+    }
+
+public:
+    explicit ResponseReader(int socketFd) : fd(socketFd), buffer(1 << 16) {}
+
+    /**
+     * @brief Читает очередной ответ.
+     * @param header Заголовок ответа.
+     * @param values Значения ответа; nullptr — значения пропускаются.
+     */
+    void next(ResponseHeader& header, vector<int32_t>* values) {
+        readExact(reinterpret_cast<char*>(&header), sizeof(header));
+        if (values) {
+            values->resize(header.count);
+            readExact(reinterpret_cast<char*>(values->data()), sizeof(int32_t) * header.count);
+        } else {
+            readExact(nullptr, sizeof(int32_t) * header.count);
+        }
+    }
+};
+
+/**
+ * @brief Запрашивает у сервера количество вершин графа.
+ */
+int queryVertexCount(const string& path) {
+    int fd = connectTo(path);
+    RequestFrame request{0, REQUEST_INFO, 0, 0};
+    sendAll(fd, string(reinterpret_cast<const char*>(&request), sizeof(request)));
+    ResponseReader reader(fd);
+    ResponseHeader header;
+    vector<int32_t> values;
+    reader.next(header, &values);
+    close(fd);
+    if (header.status != STATUS_OK || values.size() != 1) {
+        throw runtime_error("Некорректный ответ сервера на запрос информации");
+    }
+    return values[0];
+}
+
+} // namespace
+
+LoadGeneratorOptions parseLoadGeneratorOptions(int argc, char* argv[]) {
+    LoadGeneratorOptions options;
+
+    forEachOption(argc, argv, 2, [&](const string& arg, const string& value) {
+        if (arg == "--socket") {
+            options.socketPath = value;
+        } else if (arg == "--requests") {
+            options.requests = parseIntegerOption(arg, value, 1, numeric_limits<long long>::max());
+        } else if (arg == "--connections") {
+            options.connections = static_cast<int>(parseIntegerOption(arg, value, 1, numeric_limits<int>::max()));
+        } else if (arg == "--pipeline") {
+            options.pipeline = static_cast<int>(parseIntegerOption(arg, value, 1, numeric_limits<int>::max()));
+        } else if (arg == "--mode") {
+            if (value != "point" && value != "sssp") {
+                throw runtime_error("Неизвестный тип запросов: " + value);
+            }
+            options.mode = value;
+        } else if (arg == "--seed") {
+            options.seed = static_cast<unsigned>(parseIntegerOption(arg, value, 0, numeric_limits<unsigned>::max()));
+        } else {
+            throw runtime_error("Неизвестный параметр: " + arg);
+        }
+    });
+
+    if (options.socketPath.empty()) {
+        throw runtime_error("Использование: --loadgen --socket путь [--requests N] [--connections C] "
+                            "[--pipeline P] [--mode point|sssp] [--seed S]");
+    }
+    return options;
+}
+
+void runLoadGenerator(const LoadGeneratorOptions& options) {
+    const int vertexCount = queryVertexCount(options.socketPath);
+    if (vertexCount <= 0) {
+        throw runtime_error("Граф на сервере пуст");
+    }
+    const uint32_t type = options.mode == "sssp" ? REQUEST_SSSP : REQUEST_POINT;
+
+    vector<vector<double>> latencies(options.connections);
+    atomic<long long> errors(0);
+    vector<string> failures(options.connections);
+
+    auto client = [&](int index) {
+        long long quota = options.requests / options.connections +
+                          (index < options.requests % options.connections ? 1 : 0);
+        vector<double>& samples = latencies[index];
+        samples.reserve(quota);
+
+        try {
+            int fd = connectTo(options.socketPath);
+            ResponseReader reader(fd);
+            mt19937 rng(options.seed + index);
+            uniform_int_distribution<int> pick(0, vertexCount - 1);
+            vector<chrono::steady_clock::time_point> sentAt(quota);
+            string batch;
+
+            long long sent = 0;
+            long long received = 0;
+            while (received < quota) {
+                batch.clear();
+                while (sent < quota && sent - received < options.pipeline) {
+                    RequestFrame request{static_cast<uint32_t>(sent), type, pick(rng), pick(rng)};
+                    batch.append(reinterpret_cast<const char*>(&request), sizeof(request));
+                    sentAt[sent] = chrono::steady_clock::now();
+                    ++sent;
+                }
+                if (!batch.empty()) {
+                    sendAll(fd, batch);
+                }
+
+                ResponseHeader header;
+                reader.next(header, nullptr);
+                auto now = chrono::steady_clock::now();
+                if (header.status != STATUS_OK || header.id >= sentAt.size()) {
+                    errors++;
+                } else {
+                    samples.push_back(chrono::duration<double, micro>(now - sentAt[header.id]).count());
+                }
+                ++received;
+            }
+            close(fd);
+        } catch (const exception& e) {
+            failures[index] = e.what();
+        }
+    };
+
+    auto start = chrono::steady_clock::now();
+    vector<thread> clients;
+    for (int i = 0; i < options.connections; ++i) {
+        clients.emplace_back(client, i);
+    }
+    for (auto& t : clients) {
+        t.join();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    for (const string& failure : failures) {
+        if (!failure.empty()) {
+            throw runtime_error(failure);
+        }
+    }
+
+    vector<double> all;
+    for (auto& samples : latencies) {
+        all.insert(all.end(), samples.begin(), samples.end());
+    }
+    sort(all.begin(), all.end());
+    auto percentile = [&all](double p) {
+        return all.empty() ? 0.0 : all[min(all.size() - 1, static_cast<size_t>(p * all.size()))];
+    };
+
+    cout << "Запросов: " << all.size() + errors << " (ошибок: " << errors << ")" << endl;
+    cout << "Соединений: " << options.connections << ", глубина конвейера: " << options.pipeline << endl;
+    cout << "Время: " << seconds << " с" << endl;
+    cout << "QPS: " << (all.size() + errors) / seconds << endl;
+    cout << "Задержка, мкс: p50=" << percentile(0.50) << " p90=" << percentile(0.90)
+         << " p99=" << percentile(0.99) << " p99.9=" << percentile(0.999)
+         << " max=" << (all.empty() ? 0.0 : all.back()) << endl;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file loadgen.hpp
+ * @brief Генератор нагрузки для сервера кратчайших путей.
+ */
+
+#ifndef loadgen_hpp
+#define loadgen_hpp
+
+#include "my_lab.hpp"
+#include "protocol.hpp"
+
+/**
+ * @struct LoadGeneratorOptions
+ * @brief Параметры генератора нагрузки.
+ */
+struct LoadGeneratorOptions {
+    string socketPath; ///< Путь к Unix-сокету сервера (--socket)
+    long long requests = 100000; ///< Общее число запросов (--requests)
+    int connections = 4; ///< Число соединений, каждое в своём потоке (--connections)
+    int pipeline = 32; ///< Наибольшее число запросов без ответа на соединение (--pipeline)
+    string mode = "point"; ///< Тип запросов: "point" или "sssp" (--mode)
+    unsigned seed = 1; ///< Начальное значение генератора случайных вершин (--seed)
+};
+
+/**
+ * @brief Разбирает аргументы командной строки генератора нагрузки (после --loadgen).
+ * @param argc Количество аргументов.
+ * @param argv Аргументы командной строки.
+ * @return Параметры генератора нагрузки.
+ * @throws runtime_error Если аргументы заданы неверно.
+ */
+LoadGeneratorOptions parseLoadGeneratorOptions(int argc, char* argv[]);
+
+/**
+ * @brief Отправляет запросы со случайными вершинами и выводит QPS и перцентили задержки.
+ * @param options Параметры генератора нагрузки.
+ * @throws runtime_error Если не удалось подключиться к серверу.
+ */
+void runLoadGenerator(const LoadGeneratorOptions& options);
+
+#endif /* loadgen_hpp */
@@ -1,5 +1,10 @@
 
 #include "my_lab.hpp"
+#include "batch.hpp"
+#include "server.hpp"
+#include "loadgen.hpp"
+#include "hub_labels.hpp"
+#include "graph_builder.hpp"
 #include <iostream>
 #include <fstream>
 #include <string>
@@ -14,7 +19,33 @@ using namespace std;
  */
 void analyzeComplexity();
 
-int main() {
+/**
+ * @brief Сравнивает многоисточниковый поиск с последовательными запусками алгоритма Дейкстры.
+ *        Результаты сохраняются в файл "multisource.dat".
+ */
+void analyzeMultiSource();
+
+int main(int argc, char* argv[]) {
+    // Неинтерактивные режимы: параметры командной строки вместо диалога
+    if (argc > 1) {
+        try {
+            string mode = argv[1];
+            if (mode == "--serve") {
+                runServer(parseServerOptions(argc, argv));
+            } else if (mode == "--loadgen") {
+                runLoadGenerator(parseLoadGeneratorOptions(argc, argv));
+            } else if (mode == "--build-labels") {
+                runLabelBuild(parseLabelBuildOptions(argc, argv));
+            } else {
+                runBatch(parseBatchOptions(argc, argv));
+            }
+        } catch (const exception &e) {
+            cerr << "Ошибка: " << e.what() << endl;
+            return 1;
+        }
+        return 0;
+    }
+
     try {
         string inputFile;
         cout << "Введите имя входного файла: ";
@@ -40,6 +71,9 @@ int main() {
         cout << "1. Отобразить граф\n";
         cout << "2. Применить Алгоритм Дейкстры\n";
         cout << "3. Сравнить алгоритмы\n";
+        cout << "4. Сравнить многоисточниковый поиск\n";
+        cout << "5. Сравнить хабовые метки с алгоритмом Дейкстры\n";
+        cout << "6. Сравнить параллельное построение графа\n";
         cout << "Ваш выбор: ";
         int choice;
         cin >> choice;
@@ -89,6 +123,7 @@ int main() {
             // Вывод информации о графе
             cout << "Количество вершин: " << graph.getVertexCount() << endl;
             cout << "Количество рёбер: " << graph.getEdgeCount() << endl;
+            cout << "Тип графа: " << (graph.isUndirected() ? "неориентированный" : "ориентированный") << endl;
 
             // Вывод кратчайших расстояний
             cout << "Кратчайшие расстояния от вершины " << startVertex << ":\n";
@@ -98,6 +133,18 @@ int main() {
         } else if (choice == 3) {
             // Сравнение алгоритмов
             analyzeComplexity();
+        } else if (choice == 4) {
+            // Сравнение многоисточникового поиска с алгоритмом Дейкстры
+            analyzeMultiSource();
+            cout << "Результаты сохранены в файле multisource.dat" << endl;
+        } else if (choice == 5) {
+            // Сравнение хабовых меток с алгоритмом Дейкстры на каждый запрос
+            analyzeHubLabels();
+            cout << "Результаты сохранены в файле hub_labels.dat" << endl;
+        } else if (choice == 6) {
+            // Сравнение GraphBuilder с последовательным добавлением рёбер
+            analyzeGraphBuilder();
+            cout << "Результаты сохранены в файле graph_builder.dat" << endl;
         } else {
             cerr << "Неверный выбор. Завершение программы.\n";
         }
@@ -4,12 +4,13 @@
  */
 
 #include "my_lab.hpp"
+#include "parallel.hpp"
 
 /**
  * @brief Конструктор класса Graph.
  * @param v Количество вершин в графе.
  */
-Graph::Graph(int v) : vertices(v), adjList(v) {}
+Graph::Graph(int v) : vertices(v), adjList(v), edgeCount(0), undirected(false) {}
 
 /**
  * @brief Добавляет ребро в граф.
@@ -19,14 +20,61 @@ Graph::Graph(int v) : vertices(v), adjList(v) {}
  */
 
 void Graph::addEdge(int u, int v, int weight) {
-    adjList[u].emplace_back(v, weight);
+    edgeCount++;
+    if (!undirected) {
+        adjList[u].emplace_back(v, weight);
+        return;
+    }
+
+    // Неориентированный граф: ребро добавляется в оба списка, списки остаются упорядоченными
+    auto insertSorted = [weight](vector<pair<int, int>>& edges, int neighbor) {
+        auto pos = lower_bound(edges.begin(), edges.end(), neighbor,
+                               [](const pair<int, int>& edge, int target) { return edge.first < target; });
+        edges.insert(pos, {neighbor, weight});
+    };
+    insertSorted(adjList[u], v);
+    if (u != v) {
+        insertSorted(adjList[v], u);
+    }
+}
+
+/**
+ * @brief Читает целое число из буфера потока, пропуская пробельные символы.
+ * @param buf Буфер входного потока.
+ * @param value Прочитанное число.
+ * @return false, если число прочитать не удалось или оно не помещается в int.
+ */
+static bool readMatrixValue(streambuf* buf, int& value) {
+    const int eof = char_traits<char>::eof();
+    int c = buf->sgetc();
+    while (c != eof && isspace(c)) {
+        c = buf->snextc();
+    }
+    bool negative = c == '-';
+    if (negative) {
+        c = buf->snextc();
+    }
+    if (c == eof || !isdigit(c)) {
+        return false;
+    }
+    int result = 0;
+    do {
+        int digit = c - '0';
+        if (result > (numeric_limits<int>::max() - digit) / 10) {
+            return false; // число не помещается в int
+        }
+        result = result * 10 + digit;
+        c = buf->snextc();
+    } while (c != eof && isdigit(c));
+    value = negative ? -result : result;
+    return true;
 }
 
 /**
  * @brief Загружает граф из файла.
  * @param fileName Имя файла для загрузки графа.
  * @param startVertex Начальная вершина, считанная из файла.
- * @throws runtime_error Если файл не может быть открыт.
+ * @throws runtime_error Если файл не может быть открыт или матрица неполна.
  */
 void Graph::loadFromFile(const string& fileName, int& startVertex) {
     edgeCount = 0;
@@ -38,16 +86,55 @@ void Graph::loadFromFile(const string& fileName, int& startVertex) {
     inFile >> startVertex;
     inFile >> vertices;
     adjList.assign(vertices, vector<pair<int, int>>());
+    undirected = true;
+
+    // Строка накапливается в общем буфере и копируется в список без запаса ёмкости
+    vector<pair<int, int>> row;
+
+    // Пока матрица симметрична, элемент (i, j) при j < i сравнивается с уже
+    // сохранённым ребром (j, i). Рёбра строки j упорядочены по соседям, а строки
+    // читаются по возрастанию, поэтому cursor[j] только продвигается вперёд
+    // (после чтения строки j он указывает на первого соседа больше j).
+    vector<size_t> cursor(vertices, 0);
 
     for (int i = 0; i < vertices; ++i) {
+        row.clear();
         for (int j = 0; j < vertices; ++j) {
             int weight;
-            inFile >> weight;
+            if (!readMatrixValue(inFile.rdbuf(), weight)) {
+                throw runtime_error("Ошибка чтения матрицы смежности: " + fileName);
+            }
+            if (undirected && j < i) {
+                const auto& mirrorRow = adjList[j];
+                int mirror = 0;
+                if (cursor[j] < mirrorRow.size() && mirrorRow[cursor[j]].first == i) {
+                    mirror = mirrorRow[cursor[j]].second;
+                }
+                if (max(weight, 0) == mirror) {
+                    if (mirror > 0) {
+                        cursor[j]++;
+                        row.emplace_back(j, mirror); // обратное направление ребра {j, i}
+                    }
+                    continue;
+                }
+
+                // Первое несовпадение: списки уже содержат оба направления рёбер,
+                // поэтому граф становится ориентированным пересчётом числа рёбер
+                edgeCount = static_cast<int>(row.size());
+                for (int u = 0; u < i; ++u) {
+                    edgeCount += static_cast<int>(adjList[u].size());
+                }
+                undirected = false;
+            }
             if (weight > 0) {
-                addEdge(i, j, weight);
+                row.emplace_back(j, weight);
                 edgeCount++;
             }
         }
+        adjList[i].assign(row.begin(), row.end());
+        if (undirected) {
+            cursor[i] = upper_bound(row.begin(), row.end(), make_pair(i, numeric_limits<int>::max())) - row.begin();
+        }
     }
     inFile.close();
 }
@@ -63,10 +150,14 @@ void Graph::toGraphviz(const string& fileName) const {
         throw runtime_error("Ошибка открытия файла для записи: " + fileName);
     }
 
-    out << "digraph G {" << endl;
+    const char* edgeOp = undirected ? " -- " : " -> ";
+    out << (undirected ? "graph G {" : "digraph G {") << endl;
     for (size_t u = 0; u < adjList.size(); ++u) {
         for (const auto& [v, weight] : adjList[u]) {
-            out << "    " << u << " -> " << v << " [label=\"" << weight << "\"]:" << endl;
+            if (undirected && v < static_cast<int>(u)) {
+                continue; // ребро неориентированного графа выводится один раз
+            }
+            out << "    " << u << edgeOp << v << " [label=\"" << weight << "\"]:" << endl;
         }
     }
     out << "}" << endl;
@@ -98,7 +189,7 @@ vector<int> Graph::dijkstra(int startVertex, const string& fileName) const {
         pq.erase(pq.begin());
         deletions++;
 
-        for (const auto& [v, weight] : adjList[u]) {
+        forEachNeighbor(u, [&](int v, int weight) {
             if (dist[u] + weight < dist[v]) {
                 pq.erase({dist[v], v});
                 dist[v] = dist[u] + weight;
@@ -107,7 +198,7 @@ vector<int> Graph::dijkstra(int startVertex, const string& fileName) const {
                 insertions++;
                 relaxations++;
             }
-        }
+        });
     }
 
     ofstream outFile(fileName);
@@ -115,11 +206,16 @@ vector<int> Graph::dijkstra(int startVertex, const string& fileName) const {
         throw runtime_error("Ошибка создания файла: " + fileName);
     }
 
-    outFile << "digraph G {\n";
+    const char* edgeOp = undirected ? " -- " : " -> ";
+    outFile << (undirected ? "graph G {\n" : "digraph G {\n");
     for (int u = 0; u < vertices; ++u) {
         for (const auto& [v, weight] : adjList[u]) {
-            string color = (parent[v] == u) ? "red" : "black";
-            outFile << "  " << u << " -> " << v << " [label=\"" << weight << "\", color=" << color << "]\n";
+            if (undirected && v < u) {
+                continue;
+            }
+            bool inTree = parent[v] == u || (undirected && parent[u] == v);
+            string color = inTree ? "red" : "black";
+            outFile << "  " << u << edgeOp << v << " [label=\"" << weight << "\", color=" << color << "]\n";
         }
     }
     outFile << "}\n";
@@ -151,18 +247,395 @@ vector<int> Graph::dijkstraSimple(int startVertex) const {
             }
         }
 
+        if (dist[u] == numeric_limits<int>::max()) {
+            break; // оставшиеся вершины недостижимы
+        }
         visited[u] = true;
 
-        for (const auto& [v, weight] : adjList[u]) {
+        forEachNeighbor(u, [&](int v, int weight) {
             if (dist[u] + weight < dist[v]) {
                 dist[v] = dist[u] + weight;
             }
-        }
+        });
     }
 
     return dist;
 }
 
+/**
+ * @brief Подготавливает буферы к новому поиску.
+ * @param scratch Рабочие буферы вызывающего потока.
+ */
+void Graph::resetScratch(SearchScratch& scratch) const {
+    if (scratch.dist.size() != static_cast<size_t>(vertices)) {
+        scratch.dist.assign(vertices, numeric_limits<int>::max());
+        scratch.parent.assign(vertices, -1);
+    } else {
+        for (int v : scratch.touched) {
+            scratch.dist[v] = numeric_limits<int>::max();
+        }
+    }
+    scratch.touched.clear();
+    scratch.heap.clear();
+}
+
+/**
+ * @brief Алгоритм Дейкстры на бинарной куче с отложенным удалением и фильтром рёбер.
+ * @param startVertex Начальная вершина.
+ * @param scratch Рабочие буферы вызывающего потока.
+ * @param bound Вершины дальше bound не добавляются в кучу.
+ * @param settle Обработчик извлечённой вершины; false останавливает поиск.
+ * @param allowEdge Фильтр рёбер (u, v).
+ */
+template <typename Settle, typename Allow>
+void Graph::settleInOrder(int startVertex, SearchScratch& scratch, int bound, Settle&& settle,
+                          Allow&& allowEdge) const {
+    resetScratch(scratch);
+    vector<int>& dist = scratch.dist;
+    vector<int>& parent = scratch.parent;
+    vector<pair<int, int>>& heap = scratch.heap;
+
+    dist[startVertex] = 0;
+    parent[startVertex] = -1;
+    scratch.touched.push_back(startVertex);
+    heap.emplace_back(0, startVertex);
+
+    while (!heap.empty()) {
+        pop_heap(heap.begin(), heap.end(), greater<>());
+        auto [d, u] = heap.back();
+        heap.pop_back();
+        if (d > dist[u]) {
+            continue; // устаревшая запись кучи
+        }
+        if (!settle(u, d)) {
+            break;
+        }
+
+        forEachNeighbor(u, [&, d = d, u = u](int v, int weight) {
+            int candidate = d + weight;
+            if (candidate <= bound && candidate < dist[v] && allowEdge(u, v)) {
+                if (dist[v] == numeric_limits<int>::max()) {
+                    scratch.touched.push_back(v);
+                }
+                dist[v] = candidate;
+                parent[v] = u;
+                heap.emplace_back(candidate, v);
+                push_heap(heap.begin(), heap.end(), greater<>());
+            }
+        });
+    }
+}
+
+/**
+ * @brief Алгоритм Дейкстры на бинарной куче по всем рёбрам графа.
+ * @param startVertex Начальная вершина.
+ * @param scratch Рабочие буферы вызывающего потока.
+ * @param bound Вершины дальше bound не добавляются в кучу.
+ * @param settle Обработчик извлечённой вершины; false останавливает поиск.
+ */
+template <typename Settle>
+void Graph::settleInOrder(int startVertex, SearchScratch& scratch, int bound, Settle&& settle) const {
+    settleInOrder(startVertex, scratch, bound, settle, [](int, int) { return true; });
+}
+
+/**
+ * @brief Алгоритм Дейкстры без вывода с необязательной ранней остановкой.
+ * @param startVertex Начальная вершина.
+ * @param scratch Рабочие буферы вызывающего потока.
+ * @param targetVertex Вершина для ранней остановки (-1 — обход всего графа).
+ */
+void Graph::searchFrom(int startVertex, SearchScratch& scratch, int targetVertex) const {
+    settleInOrder(startVertex, scratch, numeric_limits<int>::max(),
+                  [targetVertex](int u, int) { return u != targetVertex; });
+}
+
+/**
+ * @brief Кратчайшее расстояние между двумя вершинами.
+ * @param startVertex Начальная вершина.
+ * @param targetVertex Конечная вершина.
+ * @param scratch Рабочие буферы вызывающего потока.
+ * @return Расстояние или INT_MAX, если вершина недостижима.
+ */
+int Graph::distance(int startVertex, int targetVertex, SearchScratch& scratch) const {
+    searchFrom(startVertex, scratch, targetVertex);
+    return scratch.dist[targetVertex];
+}
+
+/**
+ * @brief Вершины на расстоянии не больше radius.
+ * @param startVertex Начальная вершина.
+ * @param radius Наибольшее расстояние.
+ * @param scratch Рабочие буферы вызывающего потока.
+ * @return Пары (вершина, расстояние) в порядке возрастания расстояния.
+ */
+vector<pair<int, int>> Graph::dijkstraWithin(int startVertex, int radius, SearchScratch& scratch) const {
+    vector<pair<int, int>> result;
+    if (radius < 0) {
+        return result;
+    }
+    settleInOrder(startVertex, scratch, radius, [&result](int u, int d) {
+        result.emplace_back(u, d);
+        return true;
+    });
+    return result;
+}
+
+/**
+ * @brief Вершины на расстоянии не больше radius (буферы текущего потока).
+ * @param startVertex Начальная вершина.
+ * @param radius Наибольшее расстояние.
+ * @return Пары (вершина, расстояние) в порядке возрастания расстояния.
+ */
+vector<pair<int, int>> Graph::dijkstraWithin(int startVertex, int radius) const {
+    thread_local SearchScratch scratch;
+    return dijkstraWithin(startVertex, radius, scratch);
+}
+
+/**
+ * @brief k ближайших вершин из множества targets.
+ * @param startVertex Начальная вершина.
+ * @param k Количество искомых вершин.
+ * @param targets Множество вершин-кандидатов; пустое — все вершины, кроме начальной.
+ * @param scratch Рабочие буферы вызывающего потока.
+ * @return Не более k пар (вершина, расстояние) в порядке возрастания расстояния.
+ */
+vector<pair<int, int>> Graph::kNearest(int startVertex, int k, const vector<int>& targets,
+                                       SearchScratch& scratch) const {
+    vector<pair<int, int>> result;
+    if (k <= 0) {
+        return result;
+    }
+
+    // Отметка кандидатов меткой запроса, без очистки массива между запросами
+    size_t remaining = 0;
+    if (!targets.empty()) {
+        scratch.clearMarks(vertices);
+        for (int t : targets) {
+            if (scratch.setMark(t)) {
+                remaining++;
+            }
+        }
+    }
+
+    settleInOrder(startVertex, scratch, numeric_limits<int>::max(), [&](int u, int d) {
+        bool isTarget = targets.empty() ? u != startVertex : scratch.isMarked(u);
+        if (isTarget) {
+            result.emplace_back(u, d);
+            if (static_cast<int>(result.size()) == k || (!targets.empty() && --remaining == 0)) {
+                return false;
+            }
+        }
+        return true;
+    });
+    return result;
+}
+
+/**
+ * @brief k ближайших вершин из множества targets (буферы текущего потока).
+ * @param startVertex Начальная вершина.
+ * @param k Количество искомых вершин.
+ * @param targets Множество вершин-кандидатов; пустое — все вершины, кроме начальной.
+ * @return Не более k пар (вершина, расстояние) в порядке возрастания расстояния.
+ */
+vector<pair<int, int>> Graph::kNearest(int startVertex, int k, const vector<int>& targets) const {
+    thread_local SearchScratch scratch;
+    return kNearest(startVertex, k, targets, scratch);
+}
+
+/**
+ * @brief Хеш последовательности вершин пути.
+ */
+struct PathHash {
+    size_t operator()(const vector<int>& path) const {
+        size_t h = 1469598103934665603ull;
+        for (int v : path) {
+            h = (h ^ static_cast<size_t>(v)) * 1099511628211ull;
+        }
+        return h;
+    }
+};
+
+/**
+ * @brief k кратчайших простых путей (алгоритм Йена с параллельными поисками ответвлений).
+ * @param startVertex Начальная вершина.
+ * @param targetVertex Конечная вершина.
+ * @param k Количество путей.
+ * @param threads Количество потоков (0 — по числу ядер).
+ * @return Не более k путей в порядке неубывания длины.
+ */
+vector<ShortestPath> Graph::kShortestPaths(int startVertex, int targetVertex, int k, int threads) const {
+    vector<ShortestPath> accepted;
+    if (k <= 0) {
+        return accepted;
+    }
+    // Потоки запускаются один раз; на каждой итерации им раздаются вершины ответвления
+    WorkerPool pool(threads);
+    vector<SearchScratch> scratch(pool.size());
+
+    // Путь от from до targetVertex по дереву предшественников, дописанный к префиксу root
+    auto buildPath = [this, targetVertex](const SearchScratch& s, const ShortestPath* root, size_t rootSize) {
+        ShortestPath path;
+        for (int v = targetVertex; v != -1; v = s.parent[v]) {
+            path.vertices.push_back(v);
+            path.distances.push_back(s.dist[v]);
+        }
+        reverse(path.vertices.begin(), path.vertices.end());
+        reverse(path.distances.begin(), path.distances.end());
+        if (root) {
+            int offset = root->distances[rootSize - 1];
+            for (int& d : path.distances) {
+                d += offset;
+            }
+            path.vertices.insert(path.vertices.begin(), root->vertices.begin(), root->vertices.begin() + rootSize - 1);
+            path.distances.insert(path.distances.begin(), root->distances.begin(), root->distances.begin() + rootSize - 1);
+        }
+        path.length = path.distances.back();
+        return path;
+    };
+
+    searchFrom(startVertex, scratch[0], targetVertex);
+    if (scratch[0].dist[targetVertex] == numeric_limits<int>::max()) {
+        return accepted;
+    }
+    accepted.push_back(buildPath(scratch[0], nullptr, 0));
+
+    auto longer = [](const ShortestPath& a, const ShortestPath& b) {
+        return tie(a.length, a.vertices) > tie(b.length, b.vertices);
+    };
+    vector<ShortestPath> candidates; // куча по (длина, вершины)
+    unordered_set<vector<int>, PathHash> seen;
+    seen.insert(accepted[0].vertices);
+
+    while (static_cast<int>(accepted.size()) < k) {
+        const ShortestPath& previous = accepted.back();
+        const size_t spurCount = previous.vertices.size() - 1;
+        vector<ShortestPath> spurPaths(spurCount);
+        vector<char> found(spurCount, 0);
+
+        // Поиск ответвления от вершины previous.vertices[j] с корнем previous.vertices[0..j]
+        auto spurSearch = [&](size_t j, SearchScratch& s) {
+            const int spurVertex = previous.vertices[j];
+            vector<int> bannedNext;
+            for (const ShortestPath& path : accepted) {
+                if (path.vertices.size() > j + 1 &&
+                    equal(previous.vertices.begin(), previous.vertices.begin() + j + 1, path.vertices.begin())) {
+                    bannedNext.push_back(path.vertices[j + 1]);
+                }
+            }
+
+            s.clearMarks(vertices);
+            for (size_t i = 0; i < j; ++i) {
+                s.setMark(previous.vertices[i]); // вершины корня, кроме ответвления
+            }
+
+            settleInOrder(spurVertex, s, numeric_limits<int>::max(),
+                          [targetVertex](int u, int) { return u != targetVertex; },
+                          [&](int u, int v) {
+                              if (s.isMarked(v)) {
+                                  return false;
+                              }
+                              return u != spurVertex || find(bannedNext.begin(), bannedNext.end(), v) == bannedNext.end();
+                          });
+
+            if (s.dist[targetVertex] != numeric_limits<int>::max()) {
+                spurPaths[j] = buildPath(s, &previous, j + 1);
+                found[j] = 1;
+            }
+        };
+
+        pool.forEachIndex(spurCount, 1, [&](int id, size_t j) { spurSearch(j, scratch[id]); });
+
+        // Слияние кандидатов в порядке вершин ответвления — результат не зависит от числа потоков
+        for (size_t j = 0; j < spurCount; ++j) {
+            if (found[j] && seen.insert(spurPaths[j].vertices).second) {
+                candidates.push_back(std::move(spurPaths[j]));
+                push_heap(candidates.begin(), candidates.end(), longer);
+            }
+        }
+        if (candidates.empty()) {
+            break;
+        }
+        pop_heap(candidates.begin(), candidates.end(), longer);
+        accepted.push_back(std::move(candidates.back()));
+        candidates.pop_back();
+    }
+
+    return accepted;
+}
+
+/**
+ * @brief Многоисточниковый поиск кратчайших путей с векторизацией по источникам.
+ * @param sources Начальные вершины.
+ * @return Для каждого источника — вектор расстояний (INT_MAX для недостижимых вершин).
+ */
+vector<vector<int>> Graph::multiSourceDistances(const vector<int>& sources) const {
+    constexpr int lanes = MULTI_SOURCE_LANES;
+    const int unreachable = numeric_limits<int>::max() / 2; // сумма с весом ребра не переполняется
+
+    vector<vector<int>> result(sources.size());
+    vector<int> dist(static_cast<size_t>(vertices) * lanes);
+    vector<char> queued(vertices, 0);
+    vector<int> frontier;
+    vector<int> next;
+
+    for (size_t first = 0; first < sources.size(); first += lanes) {
+        size_t groupSize = min<size_t>(lanes, sources.size() - first);
+        fill(dist.begin(), dist.end(), unreachable);
+        frontier.clear();
+        for (size_t l = 0; l < groupSize; ++l) {
+            int s = sources[first + l];
+            dist[static_cast<size_t>(s) * lanes + l] = 0;
+            if (!queued[s]) {
+                queued[s] = 1;
+                frontier.push_back(s);
+            }
+        }
+
+        while (!frontier.empty()) {
+            sort(frontier.begin(), frontier.end()); // обход в порядке хранения вершин
+            for (int u : frontier) {
+                queued[u] = 0;
+            }
+
+            next.clear();
+            for (int u : frontier) {
+                // Локальная копия строки u: без неё du и dv указывают в один массив,
+                // и цикл по дорожкам не векторизуется из-за возможного перекрытия
+                int du[lanes];
+                copy_n(&dist[static_cast<size_t>(u) * lanes], lanes, du);
+                forEachNeighbor(u, [&](int v, int weight) {
+                    if (v == u) {
+                        return; // петля не улучшает расстояния
+                    }
+                    int* dv = &dist[static_cast<size_t>(v) * lanes];
+                    int improved = 0;
+                    for (int l = 0; l < lanes; ++l) {
+                        int candidate = du[l] + weight;
+                        improved |= candidate < dv[l];
+                        dv[l] = candidate < dv[l] ? candidate : dv[l];
+                    }
+                    if (improved && !queued[v]) {
+                        queued[v] = 1;
+                        next.push_back(v);
+                    }
+                });
+            }
+            frontier.swap(next);
+        }
+
+        for (size_t l = 0; l < groupSize; ++l) {
+            vector<int>& out = result[first + l];
+            out.resize(vertices);
+            for (int v = 0; v < vertices; ++v) {
+                int d = dist[static_cast<size_t>(v) * lanes + l];
+                out[v] = d >= unreachable ? numeric_limits<int>::max() : d;
+            }
+        }
+    }
+
+    return result;
+}
+
 /**
  * @brief Генерирует случайный граф и сохраняет его в файл.
  * @param fileName Имя выходного файла.
@@ -227,6 +700,62 @@ void analyzeComplexity() {
     outFile.close();
 }
 
+/**
+ * @brief Сравнивает многоисточниковый поиск с последовательными запусками алгоритма Дейкстры
+ *        на разреженных и плотных графах. Результаты сохраняются в файл "multisource.dat".
+ * @throws runtime_error Если результаты алгоритмов не совпадают.
+ */
+void analyzeMultiSource() {
+    struct Case { int vertices; double density; };
+    vector<Case> cases = {{2000, 0.005}, {4000, 0.005}, {8000, 0.005}, {500, 1.0}, {1000, 1.0}};
+    const int sourceCount = 64;
+
+    ofstream outFile("multisource.dat");
+    outFile << "Vertices Density Sources Dijkstra MultiSource\n";
+
+    for (const Case& c : cases) {
+        Graph graph(c.vertices);
+        for (int i = 0; i < c.vertices; ++i) {
+            for (int j = 0; j < c.vertices; ++j) {
+                if (i != j && rand() < c.density * RAND_MAX) {
+                    graph.addEdge(i, j, rand() % 10 + 1);
+                }
+            }
+        }
+
+        vector<int> sources(sourceCount);
+        for (int& s : sources) {
+            s = rand() % c.vertices;
+        }
+
+        // Последовательные запуски алгоритма Дейкстры
+        SearchScratch scratch;
+        vector<vector<int>> expected;
+        auto loopStart = chrono::high_resolution_clock::now();
+        for (int s : sources) {
+            graph.searchFrom(s, scratch);
+            expected.push_back(scratch.dist);
+        }
+        auto loopEnd = chrono::high_resolution_clock::now();
+        auto loopTime = chrono::duration_cast<chrono::milliseconds>(loopEnd - loopStart).count();
+
+        // Многоисточниковый поиск
+        auto multiStart = chrono::high_resolution_clock::now();
+        vector<vector<int>> actual = graph.multiSourceDistances(sources);
+        auto multiEnd = chrono::high_resolution_clock::now();
+        auto multiTime = chrono::duration_cast<chrono::milliseconds>(multiEnd - multiStart).count();
+
+        if (actual != expected) {
+            throw runtime_error("Результаты многоисточникового поиска не совпадают с алгоритмом Дейкстры");
+        }
+
+        outFile << c.vertices << " " << c.density << " " << sourceCount << " "
+                << loopTime << " " << multiTime << "\n";
+    }
+
+    outFile.close();
+}
+
 
 
 
@@ -1,3 +1,6 @@
+#ifndef my_lab_hpp
+#define my_lab_hpp
+
 #include <iostream>
 #include <fstream>
 #include <string>
@@ -6,9 +9,69 @@
 #include <vector>
 #include <set>
 #include <cstdlib>
+#include <algorithm>
+#include <functional>
 
 using namespace std;
 
+/**
+ * @struct SearchScratch
+ * @brief Рабочие буферы поиска кратчайших путей, переиспользуемые между запросами.
+ *
+ * Один экземпляр принадлежит одному потоку. Между запросами сбрасываются
+ * только вершины, затронутые предыдущим поиском, поэтому стоимость запроса
+ * не включает повторную инициализацию массивов размера V.
+ */
+struct SearchScratch {
+    vector<int> dist; ///< Текущие расстояния (INT_MAX — вершина не достигнута)
+    vector<int> touched; ///< Вершины, расстояния которых изменил последний поиск
+    vector<int> parent; ///< Предшественники в дереве кратчайших путей (действительны для touched)
+    vector<pair<int, int>> heap; ///< Бинарная куча пар (расстояние, вершина)
+    vector<unsigned> mark; ///< Метки вершин (совпадение с markStamp — вершина отмечена в текущем запросе)
+    unsigned markStamp = 0; ///< Метка текущего запроса
+
+    /**
+     * @brief Снимает все отметки сменой метки запроса; массив очищается только при переполнении метки.
+     * @param vertices Количество вершин графа.
+     */
+    void clearMarks(int vertices) {
+        if (mark.size() != static_cast<size_t>(vertices) || ++markStamp == 0) {
+            mark.assign(vertices, 0);
+            markStamp = 1;
+        }
+    }
+
+    /**
+     * @brief Отмечает вершину в текущем запросе.
+     * @param v Вершина.
+     * @return false, если вершина уже была отмечена.
+     */
+    bool setMark(int v) {
+        if (mark[v] == markStamp) {
+            return false;
+        }
+        mark[v] = markStamp;
+        return true;
+    }
+
+    /**
+     * @brief Проверяет, отмечена ли вершина в текущем запросе.
+     * @param v Вершина.
+     * @return true, если вершина отмечена.
+     */
+    bool isMarked(int v) const { return mark[v] == markStamp; }
+};
+
+/**
+ * @struct ShortestPath
+ * @brief Простой путь в графе с накопленными расстояниями.
+ */
+struct ShortestPath {
+    int length; ///< Длина пути
+    vector<int> vertices; ///< Вершины пути от начальной до конечной
+    vector<int> distances; ///< distances[i] — длина префикса пути до vertices[i]
+};
+
 /**
  * @class Graph
  * @brief Класс для представления графа и выполнения алгоритмов обработки графа.
@@ -18,10 +81,13 @@ using namespace std;
  * реализацию алгоритмов Дейкстры, а также анализ сложности.
  */
 class Graph {
+    friend class GraphBuilder;
+
 private:
     int vertices; ///< Количество вершин в графе
     vector<vector<pair<int, int>>> adjList; ///< Список смежности для представления графа
     int edgeCount; ///< Количество рёбер в графе
+    bool undirected; ///< Граф неориентированный: ребро {u, v} хранится в adjList[u] и adjList[v], но считается один раз
 
 public:
     /**
@@ -32,6 +98,8 @@ public:
 
     /**
      * @brief Добавляет ребро в граф.
+     *
+     * В неориентированном графе ребро добавляется в обоих направлениях.
      * @param u Вершина-источник.
      * @param v Вершина-назначение.
      * @param weight Вес ребра.
@@ -40,14 +108,20 @@ public:
 
     /**
      * @brief Загружает граф из файла.
+     *
+     * Симметричность матрицы проверяется во время чтения. Для симметричной
+     * матрицы граф считается неориентированным: каждое ребро учитывается
+     * один раз, а списки смежности содержат оба направления, чтобы обход
+     * соседей не искал вес ребра в чужом списке. При первом несовпадении
+     * граф становится ориентированным.
      * @param fileName Имя файла, содержащего матрицу смежности.
      * @param startVertex Начальная вершина для алгоритма.
-     * @throws runtime_error Если файл не удалось открыть.
+     * @throws runtime_error Если файл не удалось открыть или матрица неполна.
      */
     void loadFromFile(const string& fileName, int& startVertex);
 
     /**
-     * @brief Сохраняет граф в формате Graphviz.
+     * @brief Сохраняет граф в формате Graphviz (digraph или graph для неориентированного графа).
      * @param fileName Имя выходного файла.
      * @throws runtime_error Если файл не удалось открыть для записи.
      */
@@ -69,6 +143,101 @@ public:
      */
     vector<int> dijkstraSimple(int startVertex) const;
 
+    /**
+     * @brief Выполняет алгоритм Дейкстры на бинарной куче без вывода в файл и на экран.
+     *
+     * Расстояния остаются в scratch.dist. Безопасен для одновременного вызова
+     * из нескольких потоков при условии, что у каждого потока свой scratch.
+     * @param startVertex Начальная вершина.
+     * @param scratch Рабочие буферы вызывающего потока.
+     * @param targetVertex Вершина, после извлечения которой поиск останавливается (-1 — без остановки).
+     */
+    void searchFrom(int startVertex, SearchScratch& scratch, int targetVertex = -1) const;
+
+    /**
+     * @brief Вычисляет кратчайшее расстояние между двумя вершинами с ранней остановкой.
+     * @param startVertex Начальная вершина.
+     * @param targetVertex Конечная вершина.
+     * @param scratch Рабочие буферы вызывающего потока.
+     * @return Расстояние или INT_MAX, если вершина недостижима.
+     */
+    int distance(int startVertex, int targetVertex, SearchScratch& scratch) const;
+
+    /**
+     * @brief Находит все вершины на расстоянии не больше radius от начальной.
+     *
+     * Поиск останавливается, как только минимальное расстояние в куче превышает
+     * radius; в кучу не попадают вершины дальше radius. Стоимость запроса
+     * определяется размером найденного шара, а не числом вершин графа.
+     * @param startVertex Начальная вершина.
+     * @param radius Наибольшее расстояние.
+     * @param scratch Рабочие буферы вызывающего потока.
+     * @return Пары (вершина, расстояние) в порядке возрастания расстояния, включая начальную вершину.
+     */
+    vector<pair<int, int>> dijkstraWithin(int startVertex, int radius, SearchScratch& scratch) const;
+
+    /**
+     * @brief Находит все вершины на расстоянии не больше radius, используя буферы текущего потока.
+     * @param startVertex Начальная вершина.
+     * @param radius Наибольшее расстояние.
+     * @return Пары (вершина, расстояние) в порядке возрастания расстояния.
+     */
+    vector<pair<int, int>> dijkstraWithin(int startVertex, int radius) const;
+
+    /**
+     * @brief Находит k ближайших к начальной вершине вершин из заданного множества.
+     *
+     * Поиск останавливается, как только найдено k вершин множества или все его вершины.
+     * @param startVertex Начальная вершина.
+     * @param k Количество искомых вершин.
+     * @param targets Множество вершин-кандидатов; пустое — все вершины, кроме начальной.
+     * @param scratch Рабочие буферы вызывающего потока.
+     * @return Не более k пар (вершина, расстояние) в порядке возрастания расстояния.
+     */
+    vector<pair<int, int>> kNearest(int startVertex, int k, const vector<int>& targets,
+                                    SearchScratch& scratch) const;
+
+    /**
+     * @brief Находит k ближайших вершин из заданного множества, используя буферы текущего потока.
+     * @param startVertex Начальная вершина.
+     * @param k Количество искомых вершин.
+     * @param targets Множество вершин-кандидатов; пустое — все вершины, кроме начальной.
+     * @return Не более k пар (вершина, расстояние) в порядке возрастания расстояния.
+     */
+    vector<pair<int, int>> kNearest(int startVertex, int k, const vector<int>& targets = {}) const;
+
+    /**
+     * @brief Находит k кратчайших простых путей между двумя вершинами (алгоритм Йена).
+     *
+     * На каждой итерации поиски ответвлений от вершин последнего найденного пути
+     * выполняются параллельно. Каждый поиск идёт по маске графа (запрещённые
+     * вершины корня и запрещённые рёбра из вершины ответвления) без копирования
+     * графа, использует буферы своего потока и останавливается по достижении
+     * конечной вершины. Повторяющиеся кандидаты отбрасываются хеш-множеством.
+     * @param startVertex Начальная вершина.
+     * @param targetVertex Конечная вершина.
+     * @param k Количество путей.
+     * @param threads Количество потоков (0 — по числу ядер).
+     * @return Не более k путей в порядке неубывания длины.
+     */
+    vector<ShortestPath> kShortestPaths(int startVertex, int targetVertex, int k, int threads = 0) const;
+
+    /**
+     * @brief Вычисляет расстояния сразу от нескольких начальных вершин.
+     *
+     * Источники обрабатываются группами по MULTI_SOURCE_LANES: для каждой вершины
+     * хранится строка из MULTI_SOURCE_LANES расстояний, и каждое ребро релаксируется
+     * для всей группы одной векторизуемой операцией min(d[v], d[u] + w)
+     * (алгоритм Беллмана — Форда с фронтом изменившихся вершин). Список смежности
+     * читается один раз на группу, а не на каждый источник. Веса рёбер должны
+     * быть меньше INT_MAX / 2.
+     * @param sources Начальные вершины.
+     * @return Для каждого источника — вектор расстояний (INT_MAX для недостижимых вершин).
+     */
+    vector<vector<int>> multiSourceDistances(const vector<int>& sources) const;
+
+    static constexpr int MULTI_SOURCE_LANES = 16; ///< Источников в группе: 16 × int32 = одна строка кэша
+
     /**
      * @brief Анализирует сложность алгоритмов для различных размеров графа.
      *        Результаты сохраняются в файл "complexity.dat".
@@ -77,7 +246,7 @@ public:
 
     /**
      * @brief Возвращает количество рёбер в графе.
-     * @return Количество рёбер.
+     * @return Количество рёбер (ребро неориентированного графа считается один раз).
      */
     int getEdgeCount() const { return edgeCount; }
 
@@ -86,9 +255,53 @@ public:
      * @return Количество вершин.
      */
     int getVertexCount() const { return vertices; }
-};
 
+    /**
+     * @brief Проверяет, хранится ли граф как неориентированный.
+     * @return true, если матрица смежности симметрична.
+     */
+    bool isUndirected() const { return undirected; }
+
+    /**
+     * @brief Вызывает visit(v, weight) для каждого ребра, исходящего из вершины u.
+     * @param u Вершина.
+     * @param visit Функция, принимающая соседа и вес ребра.
+     */
+    template <typename Visit>
+    void forEachNeighbor(int u, Visit&& visit) const {
+        for (const auto& [v, weight] : adjList[u]) {
+            visit(v, weight);
+        }
+    }
+
+private:
+    /**
+     * @brief Подготавливает буферы к новому поиску, сбрасывая только затронутые вершины.
+     * @param scratch Рабочие буферы вызывающего потока.
+     */
+    void resetScratch(SearchScratch& scratch) const;
+
+    /**
+     * @brief Алгоритм Дейкстры, вызывающий settle(u, d) для вершин в порядке возрастания расстояния.
+     * @param startVertex Начальная вершина.
+     * @param scratch Рабочие буферы вызывающего потока.
+     * @param bound Вершины дальше bound не добавляются в кучу.
+     * @param settle Обработчик; возвращает false, чтобы остановить поиск.
+     */
+    template <typename Settle>
+    void settleInOrder(int startVertex, SearchScratch& scratch, int bound, Settle&& settle) const;
 
+    /**
+     * @brief Алгоритм Дейкстры с фильтром рёбер: ребро (u, v) используется, только если allowEdge(u, v).
+     * @param startVertex Начальная вершина.
+     * @param scratch Рабочие буферы вызывающего потока.
+     * @param bound Вершины дальше bound не добавляются в кучу.
+     * @param settle Обработчик; возвращает false, чтобы остановить поиск.
+     * @param allowEdge Фильтр рёбер.
+     */
+    template <typename Settle, typename Allow>
+    void settleInOrder(int startVertex, SearchScratch& scratch, int bound, Settle&& settle, Allow&& allowEdge) const;
+};
 
 
 
@@ -96,12 +309,8 @@ public:
 
 
 
-#ifndef my_lab_hpp
-//#define my_lab_hpp
 
-#include <stdio.h>
 
-#endif /* my_lab_hpp */
 #include <chrono>
 #include <random>
 #include <cstdlib>
@@ -115,6 +324,9 @@ public:
 #include <utility>
 #include <stdexcept>
 #include <sstream>
+#include <atomic>
+#include <thread>
+#include <unordered_set>
 /*using namespace std;
 using namespace chrono;
 
@@ -183,3 +395,5 @@ public:
     int getVertexCount() const { return vertices; }
 };
 */
+
+#endif /* my_lab_hpp */
@@ -0,0 +1,33 @@
+/**
+ * @file options.cpp
+ * @brief Реализация разбора параметров командной строки.
+ */
+
+#include "options.hpp"
+#include <charconv>
+#include <stdexcept>
+
+void forEachOption(int argc, char* argv[], int first, const function<void(const string&, const string&)>& handle) {
+    for (int i = first; i < argc; i += 2) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            throw runtime_error("Не указано значение параметра: " + arg);
+        }
+        handle(arg, argv[i + 1]);
+    }
+}
+
+long long parseIntegerOption(const string& name, const string& value, long long minValue, long long maxValue) {
+    long long result = 0;
+    const char* end = value.data() + value.size();
+    auto parsed = from_chars(value.data(), end, result);
+    if (parsed.ec == errc::result_out_of_range || (parsed.ec == errc() && parsed.ptr == end &&
+                                                   (result < minValue || result > maxValue))) {
+        throw runtime_error("Значение параметра " + name + " должно быть от " + to_string(minValue) + " до " +
+                            to_string(maxValue) + ": " + value);
+    }
+    if (parsed.ec != errc() || parsed.ptr != end) {
+        throw runtime_error("Некорректное значение параметра " + name + ": " + value);
+    }
+    return result;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file options.hpp
+ * @brief Разбор параметров командной строки вида "--имя значение".
+ */
+
+#ifndef options_hpp
+#define options_hpp
+
+#include "my_lab.hpp"
+
+/**
+ * @brief Перебирает пары "--имя значение" начиная с аргумента first.
+ * @param argc Количество аргументов.
+ * @param argv Аргументы командной строки.
+ * @param first Номер первого параметра (после имени режима).
+ * @param handle Обработчик пары (имя, значение).
+ * @throws runtime_error Если у последнего параметра нет значения.
+ */
+void forEachOption(int argc, char* argv[], int first, const function<void(const string&, const string&)>& handle);
+
+/**
+ * @brief Разбирает целочисленное значение параметра.
+ * @param name Имя параметра (для сообщения об ошибке).
+ * @param value Значение из командной строки.
+ * @param minValue Наименьшее допустимое значение.
+ * @param maxValue Наибольшее допустимое значение.
+ * @return Значение параметра.
+ * @throws runtime_error Если значение не является целым числом из [minValue, maxValue].
+ */
+long long parseIntegerOption(const string& name, const string& value, long long minValue, long long maxValue);
+
+/**
+ * @brief Разбирает количество потоков (целое от 1 до INT_MAX).
+ * @param name Имя параметра (для сообщения об ошибке).
+ * @param value Значение из командной строки.
+ * @return Количество потоков.
+ * @throws runtime_error Если значение некорректно.
+ */
+inline int parseThreadsOption(const string& name, const string& value) {
+    return static_cast<int>(parseIntegerOption(name, value, 1, numeric_limits<int>::max()));
+}
+
+#endif /* options_hpp */
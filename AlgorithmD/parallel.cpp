@@ -0,0 +1,94 @@
+/**
+ * @file parallel.cpp
+ * @brief Реализация пула рабочих потоков.
+ */
+
+#include "parallel.hpp"
+
+WorkerPool::WorkerPool(int threads) {
+    if (threads <= 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+    for (int id = 1; id < threads; ++id) {
+        workers.emplace_back(&WorkerPool::workerLoop, this, id);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        lock_guard<mutex> guard(stateMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& t : workers) {
+        t.join();
+    }
+}
+
+void WorkerPool::run(const function<void(int)>& work) {
+    if (workers.empty()) {
+        work(0);
+        return;
+    }
+
+    {
+        lock_guard<mutex> guard(stateMutex);
+        job = &work;
+        pending = static_cast<int>(workers.size());
+        failure = nullptr;
+        ++generation;
+    }
+    wake.notify_all();
+
+    // Задание ссылается на стек вызывающего, поэтому фоновые потоки дожидаются и при исключении
+    exception_ptr error;
+    try {
+        work(0);
+    } catch (...) {
+        error = current_exception();
+    }
+
+    unique_lock<mutex> guard(stateMutex);
+    done.wait(guard, [this]() { return pending == 0; });
+    job = nullptr;
+    if (!error) {
+        error = failure;
+    }
+    failure = nullptr;
+    guard.unlock();
+
+    if (error) {
+        rethrow_exception(error);
+    }
+}
+
+void WorkerPool::workerLoop(int id) {
+    unsigned long long seen = 0;
+    while (true) {
+        const function<void(int)>* work;
+        {
+            unique_lock<mutex> guard(stateMutex);
+            wake.wait(guard, [&]() { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            work = job;
+        }
+
+        exception_ptr error;
+        try {
+            (*work)(id);
+        } catch (...) {
+            error = current_exception();
+        }
+
+        lock_guard<mutex> guard(stateMutex);
+        if (error && !failure) {
+            failure = error;
+        }
+        if (--pending == 0) {
+            done.notify_one();
+        }
+    }
+}
@@ -0,0 +1,103 @@
+/**
+ * @file parallel.hpp
+ * @brief Пул рабочих потоков, общий для пакетного режима, построения меток и графа.
+ */
+
+#ifndef parallel_hpp
+#define parallel_hpp
+
+#include "my_lab.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+/**
+ * @class WorkerPool
+ * @brief Потоки, запускаемые один раз и выполняющие задания до уничтожения пула.
+ *
+ * Задание выполняется всеми потоками пула; поток 0 — вызывающий, поэтому пул
+ * из одного потока не создаёт потоков. Между заданиями потоки ждут на условной
+ * переменной, так что повторные задания (блоки запросов, итерации алгоритма)
+ * не платят за создание потоков. Задания передаются из одного потока.
+ */
+class WorkerPool {
+public:
+    /**
+     * @brief Запускает потоки пула.
+     * @param threads Количество потоков вместе с вызывающим (0 — по числу ядер).
+     */
+    explicit WorkerPool(int threads = 0);
+
+    /**
+     * @brief Останавливает и присоединяет потоки.
+     */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @brief Возвращает количество потоков вместе с вызывающим.
+     * @return Количество потоков.
+     */
+    int size() const { return static_cast<int>(workers.size()) + 1; }
+
+    /**
+     * @brief Выполняет work(id) в каждом потоке пула и дожидается завершения.
+     *
+     * Исключение, выброшенное заданием, передаётся вызывающему после
+     * завершения остальных потоков.
+     * @param work Задание; id — номер потока от 0 до size() - 1.
+     */
+    void run(const function<void(int)>& work);
+
+    /**
+     * @brief Вызывает body(id, i) для каждого i из [0, count), раздавая индексы порциями.
+     * @param count Количество индексов.
+     * @param claim Количество индексов, забираемых потоком за один раз.
+     * @param body Тело цикла; id — номер потока, выполняющего итерацию.
+     */
+    template <typename Body>
+    void forEachIndex(size_t count, size_t claim, Body&& body) {
+        if (count == 0) {
+            return;
+        }
+        claim = max<size_t>(claim, 1);
+        atomic<size_t> next(0);
+        auto work = [&](int id) {
+            size_t begin;
+            while ((begin = next.fetch_add(claim)) < count) {
+                size_t end = min(begin + claim, count);
+                for (size_t i = begin; i < end; ++i) {
+                    body(id, i);
+                }
+            }
+        };
+        if (count <= claim) {
+            work(0); // одна порция: будить потоки незачем
+        } else {
+            run(work);
+        }
+    }
+
+private:
+    /**
+     * @brief Цикл фонового потока: ожидание задания, выполнение, отчёт о завершении.
+     * @param id Номер потока.
+     */
+    void workerLoop(int id);
+
+    vector<thread> workers; ///< Фоновые потоки (номера 1..size() - 1)
+    mutex stateMutex; ///< Защищает поля ниже
+    condition_variable wake; ///< Сигнал о новом задании или остановке
+    condition_variable done; ///< Сигнал о завершении задания всеми фоновыми потоками
+    const function<void(int)>* job = nullptr; ///< Текущее задание
+    unsigned long long generation = 0; ///< Номер текущего задания
+    int pending = 0; ///< Фоновые потоки, ещё выполняющие текущее задание
+    bool stopping = false; ///< Пул уничтожается
+    exception_ptr failure; ///< Первое исключение фонового потока в текущем задании
+};
+
+#endif /* parallel_hpp */
@@ -0,0 +1,60 @@
+/**
+ * @file protocol.hpp
+ * @brief Двоичный протокол запросов к серверу кратчайших путей.
+ *
+ * Все поля — 32-битные целые в порядке байтов хоста (сокет локальный).
+ * Клиент может отправлять запросы, не дожидаясь ответов; ответы
+ * сопоставляются с запросами по идентификатору и могут приходить
+ * в другом порядке.
+ */
+
+#ifndef protocol_hpp
+#define protocol_hpp
+
+#include <cstdint>
+
+/**
+ * @brief Типы запросов.
+ */
+enum RequestType : uint32_t {
+    REQUEST_SSSP = 1, ///< Расстояния от source до всех вершин (count = V)
+    REQUEST_POINT = 2, ///< Расстояние от source до target (count = 1)
+    REQUEST_INFO = 3 ///< Количество вершин графа (count = 1)
+};
+
+/**
+ * @brief Коды состояния ответа.
+ */
+enum ResponseStatus : int32_t {
+    STATUS_OK = 0, ///< Запрос выполнен
+    STATUS_BAD_VERTEX = 1, ///< Номер вершины вне диапазона
+    STATUS_BAD_TYPE = 2 ///< Неизвестный тип запроса
+};
+
+/**
+ * @struct RequestFrame
+ * @brief Запрос фиксированного размера (16 байт).
+ */
+struct RequestFrame {
+    uint32_t id; ///< Идентификатор, возвращаемый в ответе
+    uint32_t type; ///< Тип запроса (RequestType)
+    int32_t source; ///< Начальная вершина
+    int32_t target; ///< Конечная вершина (для REQUEST_POINT)
+};
+
+/**
+ * @struct ResponseHeader
+ * @brief Заголовок ответа (12 байт), за которым следуют count расстояний int32.
+ *
+ * Недостижимые вершины передаются как -1.
+ */
+struct ResponseHeader {
+    uint32_t id; ///< Идентификатор запроса
+    int32_t status; ///< Код состояния (ResponseStatus)
+    uint32_t count; ///< Количество следующих за заголовком значений
+};
+
+static_assert(sizeof(RequestFrame) == 16, "RequestFrame должен занимать 16 байт");
+static_assert(sizeof(ResponseHeader) == 12, "ResponseHeader должен занимать 12 байт");
+
+#endif /* protocol_hpp */
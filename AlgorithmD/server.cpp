@@ -0,0 +1,572 @@
+/**
+ * @file server.cpp
+ * @brief Реализация сервера кратчайших путей: цикл событий на poll() и пул рабочих потоков.
+ */
+
+#include "server.hpp"
+#include "options.hpp"
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+const size_t kReadChunk = 1 << 16; ///< Размер одного чтения из сокета
+const size_t kMaxBatch = 256; ///< Наибольшее число запросов в одном пакете для рабочего потока
+const size_t kOutputHighWater = 1 << 26; ///< Объём неотправленных и ожидаемых ответов, при котором чтение соединения приостанавливается
+const size_t kOutputCompact = 1 << 20; ///< Отправленная часть output, после которой она удаляется из буфера
+const int kAcceptRetryMs = 100; ///< Пауза приёма соединений после исчерпания дескрипторов
+
+volatile sig_atomic_t stopRequested = 0; ///< Получен сигнал остановки
+int wakeWriteFd = -1; ///< Конец канала, пробуждающего цикл событий
+
+/**
+ * @brief Обработчик SIGINT/SIGTERM: помечает остановку и пробуждает цикл событий.
+ */
+void onStopSignal(int) {
+    stopRequested = 1;
+    if (wakeWriteFd >= 0) {
+        char byte = 0;
+        (void)!write(wakeWriteFd, &byte, 1);
+    }
+}
+
+/**
+ * @brief Переводит дескриптор в неблокирующий режим.
+ * @param fd Дескриптор.
+ */
+void setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        throw runtime_error("Ошибка настройки сокета: " + string(strerror(errno)));
+    }
+}
+
+/**
+ * @class ScopeExit
+ * @brief Выполняет действие при выходе из области видимости, в том числе по исключению.
+ */
+class ScopeExit {
+private:
+    function<void()> action;
+
+public:
+    explicit ScopeExit(function<void()> action) : action(std::move(action)) {}
+    ~ScopeExit() { action(); }
+
+    ScopeExit(const ScopeExit&) = delete;
+    ScopeExit& operator=(const ScopeExit&) = delete;
+};
+
+/**
+ * @struct Task
+ * @brief Пакет запросов одного соединения для рабочего потока.
+ */
+struct Task {
+    uint64_t connectionId; ///< Идентификатор соединения
+    vector<RequestFrame> requests; ///< Запросы пакета в порядке поступления
+    size_t reservedBytes; ///< Наибольший размер ответов пакета
+};
+
+/**
+ * @struct Completion
+ * @brief Сериализованные ответы на пакет запросов.
+ */
+struct Completion {
+    uint64_t connectionId; ///< Идентификатор соединения
+    string data; ///< Ответы пакета, готовые к отправке
+    size_t reservedBytes; ///< Размер, учтённый для пакета в Connection::pendingBytes
+};
+
+/**
+ * @struct Connection
+ * @brief Состояние клиентского соединения в цикле событий.
+ */
+struct Connection {
+    int fd; ///< Дескриптор сокета
+    string input; ///< Прочитанные, но ещё не разобранные байты
+    string output; ///< Ответы, ожидающие отправки
+    size_t outputOffset = 0; ///< Уже отправленная часть output
+    size_t pendingTasks = 0; ///< Пакеты, находящиеся у рабочих потоков
+    size_t pendingBytes = 0; ///< Наибольший размер ответов на пакеты, находящиеся у рабочих потоков
+    bool readClosed = false; ///< Клиент закрыл передачу
+    bool failed = false; ///< Ошибка ввода-вывода, соединение нужно закрыть
+};
+
+/**
+ * @class TaskQueue
+ * @brief Очередь пакетов для пула рабочих потоков.
+ */
+class TaskQueue {
+private:
+    mutex lock;
+    condition_variable ready;
+    deque<Task> tasks;
+    bool closed = false;
+
+public:
+    void push(Task&& task) {
+        {
+            lock_guard<mutex> guard(lock);
+            tasks.push_back(std::move(task));
+        }
+        ready.notify_one();
+    }
+
+    bool pop(Task& task) {
+        unique_lock<mutex> guard(lock);
+        ready.wait(guard, [this] { return closed || !tasks.empty(); });
+        if (tasks.empty()) {
+            return false;
+        }
+        task = std::move(tasks.front());
+        tasks.pop_front();
+        return true;
+    }
+
+    /**
+     * @brief Закрывает очередь; ещё не взятые пакеты отбрасываются.
+     */
+    void close() {
+        {
+            lock_guard<mutex> guard(lock);
+            closed = true;
+            tasks.clear();
+        }
+        ready.notify_all();
+    }
+};
+
+/**
+ * @brief Дописывает значение в двоичном виде в буфер ответа.
+ */
+template <typename T>
+void appendValue(string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/**
+ * @brief Приводит расстояние к виду протокола (-1 для недостижимых вершин).
+ */
+int32_t wireDistance(int value) {
+    return value == numeric_limits<int>::max() ? -1 : value;
+}
+
+/**
+ * @brief Возвращает наибольший размер ответа на запрос.
+ * @param request Запрос.
+ * @param vertexCount Количество вершин графа.
+ * @return Размер ответа в байтах.
+ */
+size_t responseBytes(const RequestFrame& request, int vertexCount) {
+    size_t values = request.type == REQUEST_SSSP ? vertexCount : 1;
+    return sizeof(ResponseHeader) + sizeof(int32_t) * values;
+}
+
+/**
+ * @brief Выполняет пакет запросов и сериализует ответы.
+ * @param graph Граф.
+ * @param requests Запросы пакета.
+ * @param scratch Рабочие буферы потока.
+ * @param cancelled Флаг остановки сервера; после его установки оставшиеся запросы пропускаются.
+ * @param out Буфер ответов.
+ */
+void processBatch(const Graph& graph, const vector<RequestFrame>& requests,
+                  SearchScratch& scratch, const atomic<bool>& cancelled, string& out) {
+    const int vertexCount = graph.getVertexCount();
+    auto valid = [vertexCount](int32_t v) { return v >= 0 && v < vertexCount; };
+
+    for (const RequestFrame& request : requests) {
+        if (cancelled.load(memory_order_relaxed)) {
+            return;
+        }
+        ResponseHeader header{request.id, STATUS_OK, 0};
+        switch (request.type) {
+        case REQUEST_INFO:
+            header.count = 1;
+            appendValue(out, header);
+            appendValue<int32_t>(out, vertexCount);
+            break;
+        case REQUEST_POINT:
+            if (!valid(request.source) || !valid(request.target)) {
+                header.status = STATUS_BAD_VERTEX;
+                appendValue(out, header);
+                break;
+            }
+            header.count = 1;
+            appendValue(out, header);
+            appendValue(out, wireDistance(graph.distance(request.source, request.target, scratch)));
+            break;
+        case REQUEST_SSSP: {
+            if (!valid(request.source)) {
+                header.status = STATUS_BAD_VERTEX;
+                appendValue(out, header);
+                break;
+            }
+            graph.searchFrom(request.source, scratch);
+            header.count = vertexCount;
+            appendValue(out, header);
+            size_t offset = out.size();
+            out.resize(offset + sizeof(int32_t) * vertexCount);
+            char* dst = out.data() + offset;
+            for (int v = 0; v < vertexCount; ++v) {
+                int32_t d = wireDistance(scratch.dist[v]);
+                memcpy(dst + sizeof(int32_t) * v, &d, sizeof(d));
+            }
+            break;
+        }
+        default:
+            header.status = STATUS_BAD_TYPE;
+            appendValue(out, header);
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Создаёт слушающий Unix-сокет.
+ * @param path Путь к сокету; существующий файл заменяется.
+ * @return Дескриптор сокета.
+ */
+int createListener(const string& path) {
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw runtime_error("Слишком длинный путь к сокету: " + path);
+    }
+    address.sun_family = AF_UNIX;
+    memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        throw runtime_error("Ошибка создания сокета: " + string(strerror(errno)));
+    }
+    unlink(path.c_str());
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(fd, SOMAXCONN) < 0) {
+        int error = errno;
+        close(fd);
+        throw runtime_error("Ошибка открытия сокета " + path + ": " + strerror(error));
+    }
+    setNonBlocking(fd);
+    return fd;
+}
+
+/**
+ * @brief Отправляет накопленные ответы, пока сокет принимает данные.
+ * @param connection Соединение.
+ */
+void flushOutput(Connection& connection) {
+    while (connection.outputOffset < connection.output.size()) {
+        ssize_t written = write(connection.fd, connection.output.data() + connection.outputOffset,
+                                connection.output.size() - connection.outputOffset);
+        if (written > 0) {
+            connection.outputOffset += written;
+        } else if (written < 0 && errno == EINTR) {
+            continue;
+        } else {
+            if (written < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+                connection.failed = true;
+            }
+            break;
+        }
+    }
+
+    // Отправленная часть удаляется, когда она велика и занимает не меньше половины буфера,
+    // поэтому буфер постоянно занятого соединения не растёт на весь объём отправленных данных
+    if (connection.outputOffset == connection.output.size()) {
+        connection.output.clear();
+        connection.outputOffset = 0;
+    } else if (connection.outputOffset >= kOutputCompact && connection.outputOffset * 2 >= connection.output.size()) {
+        connection.output.erase(0, connection.outputOffset);
+        connection.outputOffset = 0;
+    }
+}
+
+/**
+ * @brief Возвращает объём неотправленных и ещё не вычисленных ответов соединения.
+ * @param connection Соединение.
+ * @return Размер в байтах.
+ */
+size_t backlogBytes(const Connection& connection) {
+    return connection.output.size() - connection.outputOffset + connection.pendingBytes;
+}
+
+/**
+ * @brief Передаёт полные запросы соединения пулу рабочих потоков пакетами.
+ *
+ * Пакет завершается, как только наибольший размер его ответов исчерпывает
+ * остаток kOutputHighWater (в пакете всегда есть хотя бы один запрос), поэтому
+ * объём неотправленных и ожидаемых ответов превышает порог не больше чем
+ * на один ответ. Оставшиеся запросы ждут в input.
+ * @param connection Соединение.
+ * @param connectionId Идентификатор соединения.
+ * @param vertexCount Количество вершин графа.
+ * @param tasks Очередь пакетов.
+ */
+void dispatchRequests(Connection& connection, uint64_t connectionId, int vertexCount, TaskQueue& tasks) {
+    size_t frameCount = connection.input.size() / sizeof(RequestFrame);
+    size_t first = 0;
+    while (first < frameCount && backlogBytes(connection) < kOutputHighWater) {
+        const size_t budget = kOutputHighWater - backlogBytes(connection);
+        Task task{connectionId, vector<RequestFrame>(), 0};
+        while (task.requests.size() < kMaxBatch && first < frameCount && task.reservedBytes < budget) {
+            RequestFrame request;
+            memcpy(&request, connection.input.data() + first * sizeof(RequestFrame), sizeof(RequestFrame));
+            task.reservedBytes += responseBytes(request, vertexCount);
+            task.requests.push_back(request);
+            ++first;
+        }
+        connection.pendingTasks++;
+        connection.pendingBytes += task.reservedBytes;
+        tasks.push(std::move(task));
+    }
+    connection.input.erase(0, first * sizeof(RequestFrame));
+}
+
+} // namespace
+
+ServerOptions parseServerOptions(int argc, char* argv[]) {
+    ServerOptions options;
+    options.threads = max(1u, thread::hardware_concurrency());
+
+    forEachOption(argc, argv, 2, [&](const string& arg, const string& value) {
+        if (arg == "--graph") {
+            options.graphFile = value;
+        } else if (arg == "--socket") {
+            options.socketPath = value;
+        } else if (arg == "--threads") {
+            options.threads = parseThreadsOption(arg, value);
+        } else {
+            throw runtime_error("Неизвестный параметр: " + arg);
+        }
+    });
+
+    if (options.graphFile.empty() || options.socketPath.empty()) {
+        throw runtime_error("Использование: --serve --graph файл --socket путь [--threads N]");
+    }
+    return options;
+}
+
+void runServer(const ServerOptions& options) {
+    Graph graph(0);
+    int startVertex;
+    graph.loadFromFile(options.graphFile, startVertex);
+
+    // Ресурсы освобождаются в обратном порядке на любом пути выхода, в том числе по исключению
+    int wakePipe[2];
+    if (pipe(wakePipe) < 0) {
+        throw runtime_error("Ошибка создания канала: " + string(strerror(errno)));
+    }
+    ScopeExit closePipe([&]() {
+        wakeWriteFd = -1;
+        close(wakePipe[0]);
+        close(wakePipe[1]);
+    });
+    setNonBlocking(wakePipe[0]);
+    setNonBlocking(wakePipe[1]);
+    int listenFd = createListener(options.socketPath);
+    ScopeExit closeListener([&]() {
+        close(listenFd);
+        unlink(options.socketPath.c_str());
+    });
+
+    wakeWriteFd = wakePipe[1];
+    stopRequested = 0;
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT, onStopSignal);
+    signal(SIGTERM, onStopSignal);
+
+    const int vertexCount = graph.getVertexCount();
+    TaskQueue tasks;
+    atomic<bool> cancelled(false);
+    mutex completionLock;
+    vector<Completion> completions;
+
+    // Рабочие потоки завершают текущий запрос; пакеты в очереди и остаток пакетов отбрасываются
+    vector<thread> workers;
+    ScopeExit stopWorkers([&]() {
+        cancelled = true;
+        tasks.close();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    });
+    for (int i = 0; i < options.threads; ++i) {
+        workers.emplace_back([&]() {
+            SearchScratch scratch;
+            Task task;
+            while (tasks.pop(task)) {
+                Completion completion{task.connectionId, string(), task.reservedBytes};
+                processBatch(graph, task.requests, scratch, cancelled, completion.data);
+                {
+                    lock_guard<mutex> guard(completionLock);
+                    completions.push_back(std::move(completion));
+                }
+                char byte = 0;
+                (void)!write(wakePipe[1], &byte, 1);
+            }
+        });
+    }
+
+    cout << "Сервер запущен: " << options.socketPath << " (вершин: " << vertexCount
+         << ", потоков: " << options.threads << ")" << endl;
+
+    unordered_map<uint64_t, Connection> connections;
+    ScopeExit closeConnections([&]() {
+        for (auto& [id, connection] : connections) {
+            close(connection.fd);
+        }
+    });
+    uint64_t nextConnectionId = 0;
+    // Дескрипторы исчерпаны: слушающий сокет не опрашивается до закрытия соединения или до acceptResume
+    bool acceptPaused = false;
+    chrono::steady_clock::time_point acceptResume;
+    vector<pollfd> pollFds;
+    vector<uint64_t> pollIds;
+    vector<Completion> ready;
+    vector<char> readBuffer(kReadChunk);
+
+    while (!stopRequested) {
+        int timeout = -1;
+        if (acceptPaused) {
+            auto left = chrono::duration_cast<chrono::milliseconds>(acceptResume - chrono::steady_clock::now()).count();
+            if (left > 0) {
+                timeout = static_cast<int>(left);
+            } else {
+                acceptPaused = false;
+            }
+        }
+        pollFds.clear();
+        pollIds.clear();
+        pollFds.push_back({wakePipe[0], POLLIN, 0});
+        pollFds.push_back({listenFd, static_cast<short>(acceptPaused ? 0 : POLLIN), 0});
+        for (auto& [id, connection] : connections) {
+            short events = 0;
+            size_t unsent = connection.output.size() - connection.outputOffset;
+            if (!connection.readClosed && backlogBytes(connection) < kOutputHighWater) {
+                events |= POLLIN;
+            }
+            if (unsent > 0) {
+                events |= POLLOUT;
+            }
+            if (events == 0) {
+                continue; // ждёт только ответов рабочих потоков
+            }
+            pollFds.push_back({connection.fd, events, 0});
+            pollIds.push_back(id);
+        }
+
+        if (poll(pollFds.data(), pollFds.size(), timeout) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw runtime_error("Ошибка poll: " + string(strerror(errno)));
+        }
+
+        // Готовые ответы рабочих потоков
+        if (pollFds[0].revents & POLLIN) {
+            char drain[256];
+            while (read(wakePipe[0], drain, sizeof(drain)) > 0) {
+            }
+            {
+                lock_guard<mutex> guard(completionLock);
+                ready.swap(completions);
+            }
+            for (Completion& completion : ready) {
+                auto it = connections.find(completion.connectionId);
+                if (it == connections.end()) {
+                    continue;
+                }
+                Connection& connection = it->second;
+                connection.pendingTasks--;
+                connection.pendingBytes -= completion.reservedBytes;
+                connection.output += completion.data;
+                flushOutput(connection);
+                dispatchRequests(connection, it->first, vertexCount, tasks);
+            }
+            ready.clear();
+        }
+
+        // Новые соединения
+        if (pollFds[1].revents & POLLIN) {
+            while (true) {
+                int clientFd = accept(listenFd, nullptr, nullptr);
+                if (clientFd < 0) {
+                    if (errno == EINTR || errno == ECONNABORTED) {
+                        continue;
+                    }
+                    // EMFILE, ENFILE и подобные: сокет остаётся готовым к чтению, и без паузы
+                    // цикл событий занимал бы процессор полностью
+                    if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                        acceptPaused = true;
+                        acceptResume = chrono::steady_clock::now() + chrono::milliseconds(kAcceptRetryMs);
+                    }
+                    break;
+                }
+                try {
+                    setNonBlocking(clientFd);
+                } catch (const runtime_error&) {
+                    close(clientFd); // ошибка одного соединения не останавливает сервер
+                    continue;
+                }
+                Connection connection;
+                connection.fd = clientFd;
+                connections.emplace(nextConnectionId++, std::move(connection));
+            }
+        }
+
+        // Чтение запросов и отправка ответов
+        for (size_t i = 2; i < pollFds.size(); ++i) {
+            auto it = connections.find(pollIds[i - 2]);
+            Connection& connection = it->second;
+            short revents = pollFds[i].revents;
+
+            // Чтение только при свободном месте: иначе данные остаются в буфере сокета
+            if (!connection.readClosed && backlogBytes(connection) < kOutputHighWater &&
+                (revents & (POLLIN | POLLHUP | POLLERR))) {
+                ssize_t received = read(connection.fd, readBuffer.data(), readBuffer.size());
+                if (received > 0) {
+                    connection.input.append(readBuffer.data(), received);
+                } else if (received == 0) {
+                    connection.readClosed = true;
+                } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    connection.failed = true;
+                }
+                dispatchRequests(connection, it->first, vertexCount, tasks);
+            }
+
+            if (revents & POLLOUT) {
+                flushOutput(connection);
+                dispatchRequests(connection, it->first, vertexCount, tasks);
+            }
+        }
+
+        for (auto it = connections.begin(); it != connections.end();) {
+            Connection& connection = it->second;
+            bool drained = connection.readClosed && connection.pendingTasks == 0 &&
+                           connection.input.size() < sizeof(RequestFrame) &&
+                           connection.outputOffset == connection.output.size();
+            if (connection.failed || drained) {
+                close(connection.fd);
+                it = connections.erase(it);
+                acceptPaused = false;
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    cout << "Сервер остановлен" << endl;
+}
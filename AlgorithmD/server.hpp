@@ -0,0 +1,45 @@
+/**
+ * @file server.hpp
+ * @brief Режим сервера: граф загружается один раз и обслуживает запросы через Unix-сокет.
+ */
+
+#ifndef server_hpp
+#define server_hpp
+
+#include "my_lab.hpp"
+#include "protocol.hpp"
+
+/**
+ * @struct ServerOptions
+ * @brief Параметры режима сервера.
+ */
+struct ServerOptions {
+    string graphFile; ///< Файл с матрицей смежности графа (--graph)
+    string socketPath; ///< Путь к Unix-сокету (--socket)
+    int threads = 1; ///< Количество рабочих потоков (--threads)
+};
+
+/**
+ * @brief Разбирает аргументы командной строки режима сервера (после --serve).
+ * @param argc Количество аргументов.
+ * @param argv Аргументы командной строки.
+ * @return Параметры сервера.
+ * @throws runtime_error Если аргументы заданы неверно.
+ */
+ServerOptions parseServerOptions(int argc, char* argv[]);
+
+/**
+ * @brief Загружает граф и обслуживает запросы до получения SIGINT или SIGTERM.
+ *
+ * Цикл событий на poll() принимает соединения и читает запросы; все полные
+ * запросы, прочитанные из соединения за один раз, передаются пулу рабочих
+ * потоков пакетами, ответы пакета отправляются одним буфером. Чтение
+ * соединения приостанавливается, пока неотправленные ответы вместе с наибольшим
+ * размером ответов на переданные пулу запросы занимают не меньше 64 МиБ.
+ * При остановке запросы в очереди отбрасываются.
+ * @param options Параметры сервера.
+ * @throws runtime_error Если не удалось загрузить граф или создать сокет.
+ */
+void runServer(const ServerOptions& options);
+
+#endif /* server_hpp */